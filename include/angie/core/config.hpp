@@ -37,6 +37,22 @@
 #define ANGIE_DEFAULT_MEMORY_ALIGNMENT 16
 #endif
 
+/**
+ * Size of a cache line, the alignment that avoids false sharing.
+ */
+#ifndef ANGIE_CACHE_LINE_SIZE
+#define ANGIE_CACHE_LINE_SIZE 64
+#endif
+
+/**
+ * Alignment of the widest vector loads used on hot data.
+ *
+ * 32 bytes matches AVX, builds targeting AVX-512 can raise it to 64.
+ */
+#ifndef ANGIE_SIMD_ALIGNMENT
+#define ANGIE_SIMD_ALIGNMENT 32
+#endif
+
 /**
  * Maximum allocable size in one call from the system.
  *
@@ -46,4 +62,110 @@
  */
 #ifndef ANGIE_MAX_ALLOCATION_SIZE
 #define ANGIE_MAX_ALLOCATION_SIZE (1 << 30)
-#endif
\ No newline at end of file
+#endif
+
+/**
+ * Size of the slabs, used by the pool allocator, to pack fixed-size blocks.
+ *
+ * It must be a power of two, and it is expected to match the page size.
+ */
+#ifndef ANGIE_MEMORY_POOL_SLAB_SIZE
+#define ANGIE_MEMORY_POOL_SLAB_SIZE 4096
+#endif
+
+/**
+ * Number of slabs the pool allocator requests at once to its parent.
+ *
+ * Slabs are aligned to their size, requesting more than one at the
+ * time, amortises the padding the parent allocator may need to align.
+ */
+#ifndef ANGIE_MEMORY_POOL_CHUNK_SLABS
+#define ANGIE_MEMORY_POOL_CHUNK_SLABS 16
+#endif
+
+/**
+ * Size of the memory areas the TLSF backend requests to the system.
+ *
+ * When an allocation can't be served by the current areas, a new one,
+ * at least this big, is added to the allocator.
+ */
+#ifndef ANGIE_MEMORY_TLSF_AREA_SIZE
+#define ANGIE_MEMORY_TLSF_AREA_SIZE (32 << 20)
+#endif
+
+/**
+ * Address space the virtual memory allocator reserves for every block.
+ *
+ * Blocks grow in place, committing more pages, until they reach this
+ * size. Reserving address space doesn't consume physical memory.
+ */
+#ifndef ANGIE_MEMORY_VMEM_RESERVE
+#define ANGIE_MEMORY_VMEM_RESERVE (1 << 30)
+#endif
+
+/**
+ * Least size of the blocks the huge page allocator maps from the system.
+ *
+ * Smaller blocks are served by its parent allocator, since they would
+ * waste most of a huge page.
+ */
+#ifndef ANGIE_MEMORY_HUGE_THRESHOLD
+#define ANGIE_MEMORY_HUGE_THRESHOLD (1 << 21)
+#endif
+
+/**
+ * Milliseconds between two reports of the memory statistics.
+ *
+ * Reports are emitted only when ANGIE_MEMORY_STATISTICS is defined.
+ */
+#ifndef ANGIE_MEMORY_STATISTICS_PERIOD
+#define ANGIE_MEMORY_STATISTICS_PERIOD 5000
+#endif
+
+/**
+ * Average number of bytes allocated between two samples of the profiler.
+ *
+ * Samples are taken only when ANGIE_MEMORY_PROFILER is defined.
+ */
+#ifndef ANGIE_MEMORY_PROFILER_RATE
+#define ANGIE_MEMORY_PROFILER_RATE (512 << 10)
+#endif
+
+/**
+ * Maximum number of frames the profiler captures per sample.
+ */
+#ifndef ANGIE_MEMORY_PROFILER_DEPTH
+#define ANGIE_MEMORY_PROFILER_DEPTH 32
+#endif
+
+/**
+ * Number of bytes of the scratch memory of every thread.
+ */
+#ifndef ANGIE_MEMORY_SCRATCH_SIZE
+#define ANGIE_MEMORY_SCRATCH_SIZE (1 << 20)
+#endif
+
+/**
+ * Resident bytes above which the background trimmer flushes memory.
+ *
+ * The trimmer runs only when ANGIE_MEMORY_TRIMMER is defined.
+ */
+#ifndef ANGIE_MEMORY_TRIM_TARGET
+#define ANGIE_MEMORY_TRIM_TARGET (256 << 20)
+#endif
+
+/**
+ * Milliseconds between two samples of the background trimmer.
+ */
+#ifndef ANGIE_MEMORY_TRIM_PERIOD
+#define ANGIE_MEMORY_TRIM_PERIOD 1000
+#endif
+
+/**
+ * Number of bytes beyond which memory copies and sets bypass the caches.
+ *
+ * Used only when the size of the last level cache can't be queried.
+ */
+#ifndef ANGIE_MEMORY_STREAM_THRESHOLD
+#define ANGIE_MEMORY_STREAM_THRESHOLD (8 << 20)
+#endif
@@ -6,10 +6,15 @@
 
 #pragma once
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "angie/core/types.hpp"
 #include "angie/core/utils.hpp"
 #include "angie/core/algorithm.hpp"
 #include "angie/core/memory/allocator.hpp"
+#include "angie/core/memory/global.hpp"
 #include "angie/core/memory/manipulation.hpp"
 #include "angie/core/debug/assert.hpp"
 
@@ -35,6 +40,20 @@ namespace angie {
 				none = end			/*!< Identifies and invalid index */
 			};
 
+			/**
+			 * How the capacity grows when the array runs out of space.
+			 *
+			 * Power of two growth reallocates the least, but it can waste up
+			 * to half of the buffer, which hurts on large arrays, where the
+			 * other policies trade more reallocations for less memory.
+			 */
+			enum class growth : types::uint8 {
+				power_of_two,	/*!< Next power of two, the default */
+				geometric,		/*!< 1.5 times the current capacity */
+				chunked,		/*!< Next multiple of `chunk` elements */
+				exact			/*!< Exactly the number of elements needed */
+			};
+
 			/**
 			 * Compute the capacity from the given size.
 			 *
@@ -52,6 +71,47 @@ namespace angie {
 				return count ? utils::next_power_of_two(count) : 0;
 			}
 
+			/**
+			 * Compute the capacity needed to hold `count` elements.
+			 *
+			 * The current capacity is kept if it is already enough, otherwise,
+			 * the new one is computed according to the growth policy.
+			 *
+			 * @param policy Growth policy of the array
+			 * @param capacity Current capacity
+			 * @param count Number of elements the array must hold
+			 * @param chunk Elements per chunk, for `growth::chunked`;
+			 * zero makes it behave as `growth::exact`
+			 * @return Capacity greater or equal to `count`
+			 */
+			inline types::size compute_capacity(growth policy,
+				types::size capacity, types::size count, types::size chunk) {
+				if (count <= capacity) {
+					return capacity;
+				}
+
+				switch (policy) {
+				case growth::power_of_two:
+					return compute_capacity(count);
+
+				case growth::geometric: {
+					// Fall back to the exact count on overflow
+					auto next = capacity + (capacity >> 1);
+					return next > count ? next : count;
+				}
+
+				case growth::chunked:
+					if (chunk && count <= SIZE_MAX - (chunk - 1)) {
+						return ((count + chunk - 1) / chunk) * chunk;
+					}
+					return count;
+
+				case growth::exact:
+				default:
+					return count;
+				}
+			}
+
 			/**
 			 * Compute the number of elements from the given size in bytes.
 			 *
@@ -85,13 +145,202 @@ namespace angie {
 			 */
 			template <typename T>
 			constexpr inline types::size get_align() {
-				return sizeof(T);
+				return alignof(T);
+			}
+
+			/**
+			 * Alignment of arrays whose elements are read by vector loads.
+			 */
+			constexpr types::size simd_align = ANGIE_SIMD_ALIGNMENT;
+
+			/**
+			 * Alignment of arrays split in cache line sized batches,
+			 * i.e. processed by different threads without false sharing.
+			 */
+			constexpr types::size cache_line_align = ANGIE_CACHE_LINE_SIZE;
+
+			/**
+			 * Whether T can be moved to another address copying its bytes.
+			 *
+			 * Arrays of such types are grown by `realloc`, and their data is
+			 * moved with the memory manipulators, like for POD types, while
+			 * other types are moved one element at a time, through their move
+			 * constructor. Specialise it for types that are not trivially
+			 * copyable, but don't care about their address, i.e. those owning
+			 * a handle, or a pointer to heap memory:
+			 *
+			 * template <>
+			 * struct is_trivially_relocatable<texture_ref> : std::true_type {};
+			 *
+			 * @tparam T Element type
+			 */
+			template <typename T>
+			struct is_trivially_relocatable : std::integral_constant<bool,
+				std::is_trivially_copyable<T>::value> {};
+
+			/**
+			 * Construct `num` elements in place.
+			 *
+			 * Trivial types are left uninitialized, as POD arrays always were.
+			 *
+			 * @tparam T Element type
+			 * @param data First element to construct
+			 * @param num Number of elements to construct
+			 */
+			template <typename T>
+			inline void construct_n(T* data, types::size num) {
+				if (!std::is_trivial<T>::value) {
+					for (types::size i = 0; i < num; ++i) {
+						new(data + i) T();
+					}
+				}
 			}
 
+			/**
+			 * Destroy `num` elements in place.
+			 *
+			 * @tparam T Element type
+			 * @param data First element to destroy
+			 * @param num Number of elements to destroy
+			 */
+			template <typename T>
+			inline void destroy_n(T* data, types::size num) {
+				if (!std::is_trivially_destructible<T>::value) {
+					for (types::size i = 0; i < num; ++i) {
+						data[i].~T();
+					}
+				}
+			}
+
+			/**
+			 * Move `num` elements to uninitialized memory, destroying them.
+			 *
+			 * Source and destination must not overlap. Trivially relocatable
+			 * types are copied in one go, other types are move constructed.
+			 *
+			 * @tparam T Element type
+			 * @param to First element to construct
+			 * @param from First element to move from
+			 * @param num Number of elements to relocate
+			 */
+			template <typename T>
+			inline void relocate_n(T* to, T* from, types::size num) {
+				if (is_trivially_relocatable<T>::value) {
+					// Move manipulator can't cope with zero size
+					if (num) {
+						memory::copy(to, from, sizeof(T) * num);
+					}
+				}
+				else {
+					for (types::size i = 0; i < num; ++i) {
+						new(to + i) T(std::move(from[i]));
+						from[i].~T();
+					}
+				}
+			}
+
+			/**
+			 * Copy `num` elements over existing ones.
+			 *
+			 * Source and destination must not overlap.
+			 *
+			 * @tparam T Element type
+			 * @param to First element to overwrite
+			 * @param from First element to copy
+			 * @param num Number of elements to copy
+			 */
+			template <typename T>
+			inline void assign_n(T* to, const T* from, types::size num) {
+				if (std::is_trivially_copyable<T>::value) {
+					if (num) {
+						memory::copy(to, from, sizeof(T) * num);
+					}
+				}
+				else {
+					for (types::size i = 0; i < num; ++i) {
+						to[i] = from[i];
+					}
+				}
+			}
+
+			/**
+			 * Allocator policy requesting memory through the v-table.
+			 *
+			 * Memory comes from the allocator held by the array, which can be
+			 * any, and it can change from one array to another. Every request
+			 * is an indirect call, which the compiler can't inline.
+			 *
+			 * A policy is a type providing the static functions below, where
+			 * `ator` is the allocator held by the array, never null.
+			 */
+			struct runtime_allocator {
+				static const memory::allocator* get_allocator() {
+					return memory::get_default_allocator();
+				}
+
+				static void* alloc(const memory::allocator* ator,
+					types::size sz, types::size al) {
+					return memory::alloc(ator, sz, al);
+				}
+
+				static void dealloc(const memory::allocator* ator, void* ptr,
+					types::size sz) {
+					memory::dealloc(ator, ptr, sz);
+				}
+
+				static void* realloc(const memory::allocator* ator, void* ptr,
+					types::size sz, types::size al) {
+					return memory::realloc(ator, ptr, sz, al);
+				}
+
+				static types::boolean try_expand(const memory::allocator* ator,
+					void* ptr, types::size sz) {
+					return memory::try_expand(ator, ptr, sz);
+				}
+			};
+
+			/**
+			 * Allocator policy requesting memory straight to the global heap.
+			 *
+			 * Requests are direct calls to memory::allocate() and friends,
+			 * which the compiler can inline, or fold into the caller loops,
+			 * while the allocator held by the array only tells whether its
+			 * memory can be managed. Arrays should be initialised with the
+			 * allocator returned by `get_allocator()`, the default one, which
+			 * requests the very same memory through its v-table.
+			 */
+			struct global_allocator {
+				static const memory::allocator* get_allocator() {
+					return memory::get_default_allocator();
+				}
+
+				static void* alloc(const memory::allocator*,
+					types::size sz, types::size al) {
+					return memory::allocate(sz, al);
+				}
+
+				static void dealloc(const memory::allocator*, void* ptr,
+					types::size sz) {
+					memory::deallocate(ptr, sz);
+				}
+
+				static void* realloc(const memory::allocator*, void* ptr,
+					types::size sz, types::size al) {
+					return memory::reallocate(ptr, sz, al);
+				}
+
+				static types::boolean try_expand(const memory::allocator*,
+					void* ptr, types::size sz) {
+					return ptr && memory::try_expand(ptr, sz);
+				}
+			};
+
 			/**
 			 * Template dynamic array implementation.
 			 *
-			 * Functions operating on this structure, assume T is a POD type.
+			 * Elements can be of any type, movable and default constructible,
+			 * and those that are trivially relocatable, POD types included,
+			 * are moved around as raw memory, which is the fast path.
 			 * It is responsibility of the user to guarantee that the given
 			 * object passed to the functions, is in a `ready` state.
 			 * The allocator is not part of the object type, otherwise,
@@ -101,17 +350,44 @@ namespace angie {
 			 * array as memory cannot be requested or release internally, but
 			 * we can still use this to retrieve or copy data. It is a useful
 			 * approach in case we want to initialise static/fixed arrays.
+			 * Hot arrays can bind the allocator at compile time instead,
+			 * through a policy other than `runtime_allocator`.
+			 * The capacity only grows when the array runs out of space, by
+			 * the amount dictated by `grow`, and only shrinks on `fit()`.
+			 * Data is aligned to `align`, when greater than the alignment of
+			 * T, so that it can be read with aligned vector loads.
+			 * Borrowed data, i.e. the inline buffer of a `small` array, is
+			 * never freed, nor reallocated; growing past it moves the elements
+			 * to memory requested to the allocator, which the array owns.
 			 *
-			 * @tparam T it must be a POD type.
+			 * @tparam T Element type, see `is_trivially_relocatable`
+			 * @tparam A Allocator policy, i.e. `global_allocator`
 			 */
-			template <typename T>
+			template <typename T, typename A = runtime_allocator>
 			struct dynamic {
 				T* ANGIE_RESTRICT           data;
 				types::size                 count;
 				types::size					capacity;
 				const memory::allocator*    ator;
+				growth						grow;
+				types::boolean				borrowed;
+				types::uint16				align;
+				types::uint32				chunk;
 			};
 
+			/**
+			 * Get the alignment of the data of the given array.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param arr Array object to query
+			 * @return The array alignment, never less than the one of T
+			 */
+			template <typename T, typename A>
+			constexpr inline types::size get_align(const dynamic<T, A>& arr) {
+				return arr.align > get_align<T>() ? arr.align : get_align<T>();
+			}
+
 			/**
 			 * Check whether all properties of the structure are consistent.
 			 *
@@ -120,15 +396,15 @@ namespace angie {
 			 * @return true if all properties of the structure are consistent
 			 * false otherwise.
 			 */
-			template <typename T>
-			inline state get_state(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline state get_state(const dynamic<T, A>& arr) {
 				if (arr.data) {
 					// If data is not null, then count must be less or equal to
 					// capacity, and the capacity cannot be zero. Finally memory
-					// must be aligned to sizeof(T) and capacity power of two.
+					// must be aligned to the array alignment.
 					return (arr.capacity && arr.count <= arr.capacity &&
 						utils::is_multiple_of((types::uintptr)arr.data,
-							get_align<T>()))
+							get_align(arr)))
 						? state::ready
 						: state::inconsistent_properties;
 				}
@@ -148,11 +424,12 @@ namespace angie {
 			 * query its state with `get_state()`.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @return true if it is valid, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean is_valid(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::boolean is_valid(const dynamic<T, A>& arr) {
 				return get_state(arr) == state::ready;
 			}
 
@@ -160,13 +437,14 @@ namespace angie {
 			 * Whether two arrays are considered equals or not.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param left Array object
 			 * @param right Array object
 			 * @return true if the two arrays are equals, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean equal(const dynamic<T>& left,
-				const dynamic<T>& right) {
+			template <typename T, typename A>
+			inline types::boolean equal(const dynamic<T, A>& left,
+				const dynamic<T, A>& right) {
 				// If a shallow compare fails, then compare memory content
 				return (memory::is_equal(&left, &right, sizeof(left))
 					|| ((left.count == right.count && left.count > 0)
@@ -178,23 +456,105 @@ namespace angie {
 			 * Get data the given data of the array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @return Element at the given position
 			 */
-			template <typename T>
-			inline T* get_data(dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline T* get_data(dynamic<T, A>& arr) {
 				return arr.data;
 			}
 
+			/**
+			 * Compute the capacity the array needs to hold `count` elements.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param arr Array object to query
+			 * @param count Number of elements the array must hold
+			 * @return Capacity according to the array growth policy
+			 */
+			template <typename T, typename A>
+			inline types::size compute_capacity(const dynamic<T, A>& arr,
+				types::size count) {
+				return compute_capacity(arr.grow, arr.capacity, count, arr.chunk);
+			}
+
+			/**
+			 * Set how the capacity of the array grows.
+			 *
+			 * It doesn't reallocate the array, it only affects the
+			 * requests made after this call, including `fit()`.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param arr Array object to modify
+			 * @param policy Growth policy
+			 * @param chunk Elements per chunk, for `growth::chunked`
+			 */
+			template <typename T, typename A>
+			inline void set_growth(dynamic<T, A>& arr, growth policy,
+				types::uint32 chunk = 0) {
+				arr.grow = policy;
+				arr.chunk = chunk;
+			}
+
+			/**
+			 * Set the alignment of the array data.
+			 *
+			 * If the current buffer doesn't satisfy the new alignment, data
+			 * is moved to a new buffer, which requires a managed array.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param arr Array object to modify
+			 * @param align Power of two alignment, i.e. `cache_line_align`,
+			 * zero for the alignment of T
+			 * @return true if data is aligned as requested, false otherwise
+			 */
+			template <typename T, typename A>
+			inline types::boolean set_alignment(dynamic<T, A>& arr,
+				types::uint16 align) {
+				angie_assert(!align || utils::is_power_of_two(align));
+
+				const types::uint16 old_align = arr.align;
+				arr.align = align;
+
+				if (!arr.data || utils::is_multiple_of(
+						(types::uintptr)arr.data, get_align(arr))) {
+					return true;
+				}
+
+				auto* new_data = arr.ator ? static_cast<T*>(A::alloc(arr.ator,
+					compute_size<T>(arr.capacity), get_align(arr))) : nullptr;
+
+				// Allocation might fail
+				if (!new_data) {
+					arr.align = old_align;
+					return false;
+				}
+
+				relocate_n(new_data, arr.data, arr.count);
+				if (!arr.borrowed) {
+					A::dealloc(arr.ator, arr.data,
+						compute_size<T>(arr.capacity));
+				}
+
+				arr.data = new_data;
+				arr.borrowed = false;
+				return true;
+			}
+
 			/**
 			 * Get the number of elements hold by this array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to query
 			 * @return Number of elements in the array
 			 */
-			template <typename T>
-			inline types::size get_count(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::size get_count(const dynamic<T, A>& arr) {
 				return arr.count;
 			}
 
@@ -202,12 +562,13 @@ namespace angie {
 			 * Get the capacity of this array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to query
 			 * @return Number of max elements this array can hold without
 			 *         resizing
 			 */
-			template <typename T>
-			inline types::size get_capacity(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::size get_capacity(const dynamic<T, A>& arr) {
 				return arr.capacity;
 			}
 
@@ -215,12 +576,13 @@ namespace angie {
 			 * Access data at given position.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @param at Position to access the array at
 			 * @return Element at the given position
 			 */
-			template <typename T>
-			inline T& at(dynamic<T>& arr, types::uintptr at) {
+			template <typename T, typename A>
+			inline T& at(dynamic<T, A>& arr, types::uintptr at) {
 				angie_assert(at < arr.count);
 				return arr.data[at];
 			}
@@ -236,11 +598,12 @@ namespace angie {
 			 * is valid, it is responsibility of the user to do so if relevant.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @return true if the array is empty, false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean is_empty(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::boolean is_empty(const dynamic<T, A>& arr) {
 				return (arr.count == 0);
 			}
 
@@ -253,11 +616,12 @@ namespace angie {
 			 * array is valid, it is responsibility of the user if necessary.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @return true if the array is full, false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean is_full(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::boolean is_full(const dynamic<T, A>& arr) {
 				return (arr.count > 0 && arr.count == arr.capacity);
 			}
 
@@ -269,25 +633,37 @@ namespace angie {
 			 * be allocated, freed, or manipulated by the functions.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array object to check
 			 * @return true if an allocator is given, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean is_managed(const dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline types::boolean is_managed(const dynamic<T, A>& arr) {
 				return (arr.ator != nullptr);
 			}
 
 			/**
 			 * Release memory and zero array's properties.
 			 *
+			 * Borrowed data can't be released, the array is emptied only.
+			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr Array to empty
 			 */
-			template <typename T>
-			inline void release(dynamic<T>& arr) {
+			template <typename T, typename A>
+			inline void release(dynamic<T, A>& arr) {
 				angie_assert(is_valid(arr));
+				if (arr.borrowed) {
+					destroy_n(arr.data, arr.count);
+					arr.count = 0;
+					return;
+				}
+
 				if (arr.data && arr.ator) {
-					arr.ator->free(arr.data);
+					destroy_n(arr.data, arr.count);
+					A::dealloc(arr.ator, arr.data,
+						compute_size<T>(arr.capacity));
 					arr.data = nullptr;
 				}
 
@@ -299,38 +675,48 @@ namespace angie {
 			 * Instantiate a new array object.
 			 *
 			 * This function will allocate memory according to the `reserve`
-			 * parameter, which will be ceil-ed to the next power of two value.
+			 * parameter, which will be ceil-ed according to the growth policy.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param reserve Initial number of elements to reserve memory for
 			 * @param ator Allocator used to instantiate the array structure
 			 * and the buffer data
+			 * @param policy Growth policy of the array
+			 * @param chunk Elements per chunk, for `growth::chunked`
+			 * @param align Alignment of the data, i.e. `simd_align`,
+			 * zero for the alignment of T
 			 * @return Not null object on success, nullptr otherwise
 			 */
-			template <typename T>
-			inline dynamic<T>* make(types::size reserve = 0,
+			template <typename T, typename A = runtime_allocator>
+			inline dynamic<T, A>* make(types::size reserve = 0,
 				const memory::allocator* alloc_to_use =
-					memory::get_default_allocator()) {
+					A::get_allocator(),
+				growth policy = growth::power_of_two,
+				types::uint32 chunk = 0, types::uint16 align = 0) {
+				angie_assert(!align || utils::is_power_of_two(align));
 
 				T* data = nullptr;
 				types::size capacity = 0;
+				const types::size data_align =
+					align > get_align<T>() ? align : get_align<T>();
 
 				if (reserve) {
-					capacity = compute_capacity(reserve);
-					data = static_cast<T*>(alloc_to_use->alloc(
-						compute_size<T>(capacity), get_align<T>()));
+					capacity = compute_capacity(policy, 0, reserve, chunk);
+					data = static_cast<T*>(A::alloc(alloc_to_use,
+						compute_size<T>(capacity), data_align));
 				}
 
-				auto array_memory = alloc_to_use->alloc(sizeof(dynamic<T>),
-					sizeof(dynamic<T>));
+				auto array_memory = A::alloc(alloc_to_use,
+					sizeof(dynamic<T, A>), alignof(dynamic<T, A>));
 
 				// Memory allocation can fail
 				if (!array_memory) {
 					return nullptr;
 				}
 
-				return new(array_memory) dynamic<T> {
-					data, 0, capacity, alloc_to_use
+				return new(array_memory) dynamic<T, A> {
+					data, 0, capacity, alloc_to_use, policy, false, align, chunk
 				};
 			}
 
@@ -343,10 +729,11 @@ namespace angie {
 			 * to release the data while keeping a valid allocator.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param arr array object to destroy
 			 */
-			template <typename T>
-			inline void destroy(dynamic<T>*& arr) {
+			template <typename T, typename A>
+			inline void destroy(dynamic<T, A>*& arr) {
 				if (arr) {
 					angie_assert(is_valid(*arr));
 					auto* allocator = arr->ator;
@@ -357,13 +744,84 @@ namespace angie {
 					arr->ator = nullptr;
 
 					if (allocator) {
-						allocator->free(arr);
+						A::dealloc(allocator, arr, sizeof(dynamic<T, A>));
 					}
 
 					arr = nullptr;
 				}
 			}
 
+			/**
+			 * Grow the capacity of the array without moving its data.
+			 *
+			 * This succeeds only if the allocator supports `try_expand`,
+			 * and there is enough room after the current buffer.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to grow
+			 * @param new_capacity Number of elements the buffer must hold
+			 * @return true if the capacity has been increased in place,
+			 * false if the array would need to be reallocated.
+			 */
+			template <typename T, typename A>
+			inline types::boolean expand(dynamic<T, A>& dst,
+				types::size new_capacity) {
+				angie_assert(is_valid(dst));
+
+				if (dst.ator && dst.data && !dst.borrowed
+					&& new_capacity > dst.capacity
+					&& A::try_expand(dst.ator, dst.data,
+						compute_size<T>(new_capacity))) {
+					dst.capacity = new_capacity;
+					return true;
+				}
+
+				return false;
+			}
+
+			/**
+			 * Move the array data to a bigger buffer.
+			 *
+			 * Trivially relocatable elements are moved by `realloc`, which
+			 * may not even need to copy them, otherwise, elements are moved
+			 * one by one to a new buffer. It doesn't update the array, but
+			 * for the borrowed flag, as data moves to memory it owns.
+			 *
+			 * @tparam T Element type
+			 * @tparam A Allocator policy
+			 * @param dst Array to grow
+			 * @param new_capacity Number of elements the buffer must hold
+			 * @return The new buffer on success, nullptr otherwise
+			 */
+			template <typename T, typename A>
+			inline T* reallocate(dynamic<T, A>& dst, types::size new_capacity) {
+				angie_assert(new_capacity > dst.capacity);
+
+				if (is_trivially_relocatable<T>::value && !dst.borrowed) {
+					return static_cast<T*>(A::realloc(dst.ator, dst.data,
+						compute_size<T>(new_capacity), get_align(dst)));
+				}
+
+				auto* new_data = static_cast<T*>(A::alloc(dst.ator,
+					compute_size<T>(new_capacity), get_align(dst)));
+
+				if (new_data && dst.data) {
+					relocate_n(new_data, dst.data, dst.count);
+					if (!dst.borrowed) {
+						A::dealloc(dst.ator, dst.data,
+							compute_size<T>(dst.capacity));
+					}
+				}
+
+				// From now on, the array owns its data
+				if (new_data) {
+					dst.borrowed = false;
+				}
+
+				return new_data;
+			}
+
 			/**
 			 * Reserve space for `num` more elements.
 			 *
@@ -372,21 +830,30 @@ namespace angie {
 			 * capacity of the array, not the size.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Destination array to increase the memory of
 			 * @param num Least number of elements to reserve memory for
 			 * @return true if the function is successful, false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean reserve(dynamic<T>& dst, types::size num) {
+			template <typename T, typename A>
+			inline types::boolean reserve(dynamic<T, A>& dst, types::size num) {
 				angie_assert(is_valid(dst));
 
 				if (dst.ator && num > 0) {
 					auto new_count = num + dst.count;
-					auto new_capacity = compute_capacity(new_count);
+					auto new_capacity = compute_capacity(dst, new_count);
+
+					// Enough room already
+					if (new_capacity == dst.capacity) {
+						return true;
+					}
+
+					// Growing in place, if the allocator can, costs no copy
+					if (expand(dst, new_capacity)) {
+						return true;
+					}
 
-					auto new_data = static_cast<T*>(dst.ator->realloc(
-						dst.data, compute_size<T>(new_capacity),
-						get_align<T>()));
+					auto* new_data = reallocate(dst, new_capacity);
 
 					if (new_data) {
 						dst.capacity = new_capacity;
@@ -410,16 +877,17 @@ namespace angie {
 			 * reserve the memory to accommodate `num` elements.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Object array to initialise
 			 * @param num Initial capacity, it will be ceil-ed
-			 * to the next power of two value.
+			 * according to the growth policy of the array.
 			 * @return true if the array has been successfully initialised,
 			 * false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean init(dynamic<T>& dst, types::size num = 0,
+			template <typename T, typename A>
+			inline types::boolean init(dynamic<T, A>& dst, types::size num = 0,
 				const memory::allocator* alloc_to_use =
-					memory::get_default_allocator()) {
+					A::get_allocator()) {
 				angie_assert(is_valid(dst));
 				if (!is_empty(dst)) {
 					release(dst);
@@ -442,13 +910,15 @@ namespace angie {
 			 * if this is the case, the array will be cleared entirely.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to clear
 			 * @param num Number of last elements to clear
 			 * @param value Byte value splatted over `data`;
-			 * by default memory will be cleared to zeros
+			 * by default memory will be cleared to zeros. Elements that
+			 * are not trivially copyable are destroyed instead.
 			 */
-			template <typename T>
-			inline void clear(dynamic<T>& dst, types::size num,
+			template <typename T, typename A>
+			inline void clear(dynamic<T, A>& dst, types::size num,
 				types::uint8 value = 0) {
 				angie_assert(is_valid(dst));
 				if (num > 0) {
@@ -459,8 +929,13 @@ namespace angie {
 					angie_assert(dst.data,
 						"Non empty arrays must have valid `data`");
 
-					memory::set(dst.data + start, value,
-						compute_size<T>(n_to_clear));
+					if (std::is_trivially_copyable<T>::value) {
+						memory::set(dst.data + start, value,
+							compute_size<T>(n_to_clear));
+					}
+					else {
+						destroy_n(dst.data + start, n_to_clear);
+					}
 
 					dst.count = start;
 				}
@@ -471,16 +946,18 @@ namespace angie {
 			 *
 			 * This function will reallocate memory if the new `capacity`
 			 * calculated from the `count` value would result into an smaller
-			 * buffer than the current one. This function must be considered
+			 * buffer than the current one. It is the only function shrinking
+			 * the capacity of the array. This function must be considered
 			 * an expensive process, because, in case of a reallocation, this
 			 * function will always perform alloc/move/release operations.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean fit(dynamic<T>& dst) {
+			template <typename T, typename A>
+			inline types::boolean fit(dynamic<T, A>& dst) {
 				angie_assert(is_valid(dst));
 
 				// If dst.count = 0, then, its next power of two is 1,
@@ -494,7 +971,13 @@ namespace angie {
 					return true;
 				}
 
-				auto new_capacity = compute_capacity(dst.count);
+				// Borrowed data can't be given back anyway
+				if (dst.borrowed) {
+					return true;
+				}
+
+				auto new_capacity = compute_capacity(dst.grow, 0,
+					dst.count, dst.chunk);
 				if (new_capacity < dst.capacity) {
 					// We can't simply `realloc` here, because most of the
 					// allocators do not truly reallocate memory if the
@@ -507,8 +990,8 @@ namespace angie {
 					// this function call, hence, we allocate a new buffer of
 					// `new_capacity` size, move data from the original one
 					// and finally release the old memory.
-					auto* new_data = static_cast<T*>(dst.ator->alloc(
-						compute_size<T>(new_capacity), get_align<T>()));
+					auto* new_data = static_cast<T*>(A::alloc(dst.ator,
+						compute_size<T>(new_capacity), get_align(dst)));
 
 					// Allocation might fail
 					if (new_data == nullptr) {
@@ -521,12 +1004,12 @@ namespace angie {
 					// dst.capacity should be zero and we would never
 					// enter this block as capacity is of an unsigned.
 					angie_assert(dst.data, "dst.data can't be null");
-					memory::move(new_data, dst.data,
-						compute_size<T>(dst.count));
+					relocate_n(new_data, dst.data, dst.count);
 
 					// Whether we have allocated new memory or not, this
 					// function results in freeing the previous buffer.
-					dst.ator->free(dst.data);
+					A::dealloc(dst.ator, dst.data,
+						compute_size<T>(dst.capacity));
 					dst.data = new_data;
 					dst.capacity = new_capacity;
 				}
@@ -535,48 +1018,56 @@ namespace angie {
 			}
 
 			/**
-			 * Reallocate `data` memory to accommodate the new size.
+			 * Change the number of elements of the array.
 			 *
-			 * This function will always issue a `realloc`, although,
-			 * depending on the allocator, this may, or may not actually
-			 * reallocate the original buffer.
+			 * Memory is reallocated only when the new size exceeds the
+			 * capacity, which grows according to the growth policy of the
+			 * array, while shrinking the array never releases memory; that
+			 * is what `fit()` is for.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param new_size New number of elements in the array
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean resize(dynamic<T>& dst,
+			template <typename T, typename A>
+			inline types::boolean resize(dynamic<T, A>& dst,
 				types::size new_size) {
 				angie_assert(is_valid(dst));
 
+				// The buffer is already big enough, whatever the size
+				if (new_size <= dst.capacity) {
+					if (new_size < dst.count) {
+						destroy_n(dst.data + new_size, dst.count - new_size);
+					}
+					else {
+						construct_n(dst.data + dst.count, new_size - dst.count);
+					}
+
+					dst.count = new_size;
+					return true;
+				}
+
 				// No allocator no party
 				if (!dst.ator) {
 					return false;
 				}
 
-				auto new_capacity = compute_capacity(new_size);
+				auto new_capacity = compute_capacity(dst, new_size);
 
-				// Check whether the final capacity of the buffer would
-				// differ, if this is not the case, then, there is no need
-				// for reallocating memory.
-				if (new_capacity == dst.capacity) {
+				// Growing in place, if the allocator can, costs no copy
+				if (expand(dst, new_capacity)) {
+					construct_n(dst.data + dst.count, new_size - dst.count);
 					dst.count = new_size;
 					return true;
 				}
 
-				// If reach this point, the new capacity can either be
-				// less, or greater than the current one, in both cases
-				// we issue a `realloc`, although, memory will probably
-				// be truly reallocated only for the letter case.
-				auto* new_data = static_cast<T*>(dst.ator->realloc(
-					dst.data, compute_size<T>(new_capacity), get_align<T>()));
+				auto* new_data = reallocate(dst, new_capacity);
 
-				// Either both `capacity` and `data` are null,
-				// or both need to be valid.
-				if ((new_capacity && new_data)
-					|| (!new_capacity && !new_data)) {
+				// Allocation might fail
+				if (new_data) {
+					construct_n(new_data + dst.count, new_size - dst.count);
 					dst.data = new_data;
 					dst.count = new_size;
 					dst.capacity = new_capacity;
@@ -594,14 +1085,15 @@ namespace angie {
 			 * between `num` and `dst.count`, will not resize the array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param elem New element to overwrite with
 			 * @param from Position where starting to overwrite from
 			 * @param num Number of elements to overwrite
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean set(dynamic<T>& dst, T elem,
+			template <typename T, typename A>
+			inline types::boolean set(dynamic<T, A>& dst, T elem,
 				types::uintptr from, types::size num) {
 				angie_assert(is_valid(dst));
 				angie_assert(from < dst.count);
@@ -624,13 +1116,14 @@ namespace angie {
 			 * position will be left uninitialized.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param from Position where starting from
 			 * @param num Number of elements to add
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean make_space(dynamic<T>& dst,
+			template <typename T, typename A>
+			inline types::boolean make_space(dynamic<T, A>& dst,
 				types::uintptr from, types::size num) {
 				angie_assert(is_valid(dst));
 				angie_assert(from < SIZE_MAX);
@@ -649,7 +1142,15 @@ namespace angie {
 					// In case we are inserting somewhere in the middle of the
 					// array, then, we need to move the right part of the split
 					// to the end of the new inserted memory chunk.
-					if (from < old_count) {
+					if (from < old_count
+						&& !std::is_trivially_copyable<T>::value) {
+						// New elements at the end are default constructed,
+						// making room is a matter of moving the others over.
+						for (auto i = old_count; i-- > from;) {
+							dst.data[i + num] = std::move(dst.data[i]);
+						}
+					}
+					else if (from < old_count) {
 						// Following logic is needed to respect the assumption
 						// that we can manipulate overlapping memory buffers.
 						auto count = algorithm::min(
@@ -688,14 +1189,15 @@ namespace angie {
 			 * elements from 0 to `from` will be left uninitialized.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param elem New element value to add
 			 * @param from Position where starting from
 			 * @param num Number of elements to add
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean add(dynamic<T>& dst, T elem,
+			template <typename T, typename A>
+			inline types::boolean add(dynamic<T, A>& dst, T elem,
 				types::uintptr from, types::size num) {
 				if (make_space(dst, from, num)) {
 					// Overwrite the remaining positions with `elem`.
@@ -705,37 +1207,223 @@ namespace angie {
 				return false;
 			}
 
+			/**
+			 * Move `num` elements from `from` down to `to`.
+			 *
+			 * Memory `move` or `copy` cannot operate on overlapping buffers,
+			 * so, when the gap between the two positions is smaller than the
+			 * elements to move, they are moved one gap at a time, and one at
+			 * a time when the gap is too small to be worth a call.
+			 * Elements that are not trivially copyable are move assigned,
+			 * leaving the last `from - to` ones moved-from, but alive.
+			 *
+			 * @tparam T POD type
+			 * @param data Elements to operate on
+			 * @param to Position to move the elements to
+			 * @param from Position of the first element to move
+			 * @param num Number of elements to move
+			 */
+			template <typename T>
+			inline void shift_down(T* data, types::size to, types::size from,
+				types::size num) {
+				angie_assert(to < from);
+
+				const auto gap = from - to;
+				if (!std::is_trivially_copyable<T>::value
+					|| compute_size<T>(gap) < 64) {
+					while (num--) {
+						data[to++] = std::move(data[from++]);
+					}
+					return;
+				}
+
+				while (num > 0) {
+					auto n_to_move = algorithm::min(num, gap);
+					memory::move(data + to, data + from,
+						compute_size<T>(n_to_move));
+
+					to += n_to_move;
+					from += n_to_move;
+					num -= n_to_move;
+				}
+			}
+
+			/**
+			 * Compact the array, keeping only the elements `keep` accepts.
+			 *
+			 * Elements are visited once, in order, and kept ones are moved
+			 * down in runs, as large as possible, in a single pass over the
+			 * array, which keeps the original order of the elements.
+			 * `keep` receives the array data, and the position of the element
+			 * to test, which, along with the ones after it, is not moved yet.
+			 * This function does not reallocate memory in any how.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam K Callable as `types::boolean (const T*, types::size)`
+			 * @param dst Array to operate on
+			 * @param keep Whether the element at the given position stays
+			 * @return Number of elements removed
+			 */
+			template <typename T, typename A, typename K>
+			inline types::size compact(dynamic<T, A>& dst, K keep) {
+				angie_assert(is_valid(dst));
+
+				const auto count = dst.count;
+				types::size read = 0;
+
+				// Nothing moves until the first element to remove
+				while (read < count && keep(dst.data, read)) {
+					++read;
+				}
+
+				// Every loop starts at an element known to be removed, as
+				// `keep` may not give the same answer when asked twice.
+				auto write = read;
+				while (read < count) {
+					// Skip the removed elements...
+					do {
+						++read;
+					} while (read < count && !keep(dst.data, read));
+
+					// ...and move the next run of kept ones in one go
+					auto run = read;
+					while (++read < count && keep(dst.data, read)) {}
+					read = algorithm::min(read, count);
+
+					if (auto n_to_move = read - run) {
+						shift_down(dst.data, write, run, n_to_move);
+						write += n_to_move;
+					}
+				}
+
+				destroy_n(dst.data + write, count - write);
+				dst.count = write;
+				return count - write;
+			}
+
+			/**
+			 * Remove all the elements matching the predicate.
+			 *
+			 * Elements are kept in the order they were before the removal.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam P Callable as `types::boolean (const T&)`
+			 * @param dst Array to operate on
+			 * @param pred Whether the given element has to be removed
+			 * @return Number of elements removed
+			 * @see compact()
+			 */
+			template <typename T, typename A, typename P>
+			inline types::size remove_if(dynamic<T, A>& dst, P pred) {
+				return compact(dst, [&pred](const T* data, types::size i) {
+					return !pred(data[i]);
+				});
+			}
+
+			/**
+			 * Remove the elements at the given positions.
+			 *
+			 * Positions must be sorted in ascending order, they can repeat,
+			 * while those past the end of the array are ignored.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to operate on
+			 * @param indices Sorted positions of the elements to remove
+			 * @param num Number of positions
+			 * @return Number of elements removed
+			 * @see compact()
+			 */
+			template <typename T, typename A>
+			inline types::size remove_indices(dynamic<T, A>& dst,
+				const types::size* indices, types::size num) {
+				angie_assert(indices || !num);
+
+				types::size next = 0;
+				return compact(dst, [&](const T*, types::size i) {
+					if (next < num && indices[next] == i) {
+						while (next < num && indices[next] == i) {
+							++next;
+						}
+						return false;
+					}
+
+					angie_assert(next >= num || indices[next] > i,
+						"Positions must be sorted in ascending order");
+					return true;
+				});
+			}
+
+			/**
+			 * Remove consecutive duplicates, keeping the first of each group.
+			 *
+			 * Elements are compared through `eq`, which receives the last
+			 * element kept, and the one to test.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam E Callable as `types::boolean (const T&, const T&)`
+			 * @param dst Array to operate on
+			 * @param eq Whether the two elements are equal
+			 * @return Number of elements removed
+			 * @see compact()
+			 */
+			template <typename T, typename A, typename E>
+			inline types::size unique(dynamic<T, A>& dst, E eq) {
+				// Elements removed are all equal to the last one kept, so the
+				// previous element, not moved yet, stands in for the latter.
+				return compact(dst, [&eq](const T* data, types::size i) {
+					return i == 0 || !eq(data[i - 1], data[i]);
+				});
+			}
+
+			/**
+			 * Remove consecutive duplicates, comparing their memory.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to operate on
+			 * @return Number of elements removed
+			 */
+			template <typename T, typename A>
+			inline types::size unique(dynamic<T, A>& dst) {
+				return unique(dst, [](const T& left, const T& right) {
+					return memory::is_equal(&left, &right, sizeof(T));
+				});
+			}
+
 			/**
 			 * Remove `num` elements starting at `from` maintaining the order.
 			 *
 			 * This function will not result in memory reallocation, and it will
 			 * be potentially slower than `loose()`. Elements will be kept in
-			 * the order they were before the removal. Memory `move` or `copy`
-			 * cannot operate on overlapping buffers, and this can be the case
-			 * for the type of operations required by the function, therefore
-			 * the algorithm used cannot take advantage of such manipulators.
+			 * the order they were before the removal, the ones following the
+			 * range are moved down with as few memory moves as possible.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param from Position where starting the removal from
 			 * @param num Number of elements to remove
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean remove(dynamic<T>& dst, types::uintptr from,
+			template <typename T, typename A>
+			inline types::boolean remove(dynamic<T, A>& dst, types::uintptr from,
 				types::size num) {
 				angie_assert(from < dst.count);
 
 				// Prevent memory override
 				auto n_to_remove = algorithm::min(num, dst.count - from);
-				
-				// Overwrite one element at a time
+
 				auto remove_from = from + n_to_remove;
-				while (remove_from < dst.count) {
-					dst.data[remove_from - n_to_remove] = dst.data[remove_from];
-					++remove_from;
+				if (n_to_remove && remove_from < dst.count) {
+					shift_down(dst.data, from, remove_from,
+						dst.count - remove_from);
 				}
 
+				destroy_n(dst.data + dst.count - n_to_remove, n_to_remove);
 				dst.count -= n_to_remove;
 				return true;
 			}
@@ -752,13 +1440,14 @@ namespace angie {
 			 * This function does not reallocate memory in any how.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Array to operate on
 			 * @param from Position where starting to replace from
 			 * @param num Number of elements to remove
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean replace_with_last(dynamic<T>& dst,
+			template <typename T, typename A>
+			inline types::boolean replace_with_last(dynamic<T, A>& dst,
 				types::uintptr from, types::size num) {
 				angie_assert(from < dst.count);
 
@@ -772,10 +1461,19 @@ namespace angie {
 				
 				// Move manipulator can't cope with zero size either
 				if (auto n_to_move = dst.count - move_from) {
-					memory::move(dst.data + from, dst.data + move_from,
-						compute_size<T>(n_to_move));
+					if (std::is_trivially_copyable<T>::value) {
+						memory::move(dst.data + from, dst.data + move_from,
+							compute_size<T>(n_to_move));
+					}
+					else {
+						for (types::size i = 0; i < n_to_move; ++i) {
+							dst.data[from + i] = std::move(
+								dst.data[move_from + i]);
+						}
+					}
 				}
 
+				destroy_n(dst.data + dst.count - n_to_remove, n_to_remove);
 				dst.count -= n_to_remove;
 				return true;
 			}
@@ -787,22 +1485,25 @@ namespace angie {
 			 * It will not make space if the buffer size is greater than the
 			 * current array size. This function can be, used to de-serialize
 			 * an array from a raw blob of memory, if the array is capable of
-			 * containing enough elements.
+			 * containing enough elements, which must be trivially copyable.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param src Source buffer to copy from
 			 * @param n_bytes Number of bytes to write
 			 * @param dst Destination buffer
 			 * @param at Position where starting to write from
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
+			template <typename T, typename A>
 			inline types::boolean write_buffer(const void* src,
-				types::size n_bytes, dynamic<T>& dst,
+				types::size n_bytes, dynamic<T, A>& dst,
 				types::uintptr at = 0) {
 				angie_assert(src, "Source buffer must be valid");
 				angie_assert(at < dst.count);
 				angie_assert(n_bytes <= compute_size<T>(dst.count - at));
+				static_assert(std::is_trivially_copyable<T>::value,
+					"Raw memory can only be written over trivially copyable types");
 
 				return !!(memory::copy(dst.data + at, src, n_bytes));
 			}
@@ -818,15 +1519,17 @@ namespace angie {
 			 * available from the source array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam B Allocator policy of the source
 			 * @param dst The copy of source array
 			 * @param src Source array to copy data from
 			 * @param from Position where starting to copy from
 			 * @param num Number of elements to copy
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean copy(dynamic<T>& dst,
-				const dynamic<T>& src, types::uintptr from = 0,
+			template <typename T, typename A, typename B>
+			inline types::boolean copy(dynamic<T, A>& dst,
+				const dynamic<T, B>& src, types::uintptr from = 0,
 				types::size num = SIZE_MAX) {
 				angie_assert(from < src.count);
 				angie_assert(is_empty(dst));
@@ -837,8 +1540,8 @@ namespace angie {
 
 				auto count = algorithm::min(src.count - from, num);
 				if (count && resize(dst, count)) {
-					return !!(memory::copy(dst.data, src.data + from,
-						compute_size<T>(count)));
+					assign_n(dst.data, src.data + from, count);
+					return true;
 				}
 
 				// Do not consider zero size calls an error.
@@ -853,6 +1556,8 @@ namespace angie {
 			 * then will be copied from the source array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam B Allocator policy of the source
 			 * @param dst Destination array to grow
 			 * @param at Position where to insert elements from
 			 * @param src Source array to copy elements from
@@ -860,9 +1565,9 @@ namespace angie {
 			 * @param num Number of elements to copy
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean insert(dynamic<T>& dst, types::uintptr at,
-				const dynamic<T>& src, types::uintptr from = 0,
+			template <typename T, typename A, typename B>
+			inline types::boolean insert(dynamic<T, A>& dst, types::uintptr at,
+				const dynamic<T, B>& src, types::uintptr from = 0,
 				types::size num = SIZE_MAX) {
 				angie_assert(is_valid(dst));
 				angie_assert(at < SIZE_MAX);
@@ -870,8 +1575,8 @@ namespace angie {
 
 				auto n_to_copy = algorithm::min(src.count - from, num);
 				if (n_to_copy && make_space(dst, at, n_to_copy)) {
-					return write_buffer(src.data + from,
-						compute_size<T>(n_to_copy), dst, at);
+					assign_n(dst.data + at, src.data + from, n_to_copy);
+					return true;
 				}
 
 				// Do not consider a zero size copy an error
@@ -886,34 +1591,38 @@ namespace angie {
 			 * then will be copied from the source array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam B Allocator policy of the source
 			 * @param dst Destination array to grow
 			 * @param src Source array to copy elements from
 			 * @param from Position where starting to copy from
 			 * @param num Number of elements to copy
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean append(dynamic<T>& dst, const dynamic<T>& src,
+			template <typename T, typename A, typename B>
+			inline types::boolean append(dynamic<T, A>& dst, const dynamic<T, B>& src,
 				types::uintptr from = 0, types::size num = SIZE_MAX) {
 				angie_assert(is_valid(dst));
 				angie_assert(from < src.count);
 
-				return insert(dst, dst.count, src);
+				return insert(dst, dst.count, src, from, num);
 			}
 
 			/**
 			 * Remove the range of elements from `src` and copy to `dst`.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @tparam B Allocator policy of the destination
 			 * @param src Source array to extract elements from
 			 * @param from Position where starting to remove from
 			 * @param num Number of elements to extract
 			 * @param dst Destination array to hold the extracted elements
 			 * @return true if successful, false otherwise
 			 */
-			template <typename T>
-			inline types::boolean extract(dynamic<T>& src, types::uintptr from,
-				types::size num, dynamic<T>& dst) {
+			template <typename T, typename A, typename B>
+			inline types::boolean extract(dynamic<T, A>& src, types::uintptr from,
+				types::size num, dynamic<T, B>& dst) {
 				angie_assert(is_valid(src));
 				angie_assert(is_valid(dst));
 
@@ -929,43 +1638,147 @@ namespace angie {
 			/**
 			 * Add one element at the end of the array.
 			 *
+			 * While there is room, this is a store and an increment, the
+			 * array grows according to its policy only once it is full.
+			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Source array to add the element to
 			 * @param elem Element to add
 			 * @return true if the element has been successfully added to the
 			 *         array, false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean push(dynamic<T>& dst, T elem) {
+			template <typename T, typename A>
+			inline types::boolean push(dynamic<T, A>& dst, T elem) {
 				angie_assert(is_valid(dst));
 
-				const auto count = get_count(dst);
-				if (resize(dst, count + 1)) {
-					at(dst, count) = elem;
+				if (angie_likely(dst.count < dst.capacity)
+					|| reserve(dst, 1)) {
+					new(dst.data + dst.count++) T(std::move(elem));
 					return true;
 				}
 
 				return false;
 			}
 
+			/**
+			 * Add `num` elements at the end of the array.
+			 *
+			 * The array grows at most once, and elements are copied in
+			 * one go. Elements must not belong to the array itself, as
+			 * growing it may move its data.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to add the elements to
+			 * @param elems Elements to add
+			 * @param num Number of elements to add
+			 * @return true if successful, false otherwise
+			 */
+			template <typename T, typename A>
+			inline types::boolean push_n(dynamic<T, A>& dst, const T* elems,
+				types::size num) {
+				angie_assert(is_valid(dst));
+
+				// Do not consider zero size calls an error.
+				if (!num) {
+					return true;
+				}
+
+				angie_assert(elems, "Elements to add must be valid");
+				if (!reserve(dst, num)) {
+					return false;
+				}
+
+				if (std::is_trivially_copyable<T>::value) {
+					memory::copy(dst.data + dst.count, elems,
+						compute_size<T>(num));
+				}
+				else {
+					for (types::size i = 0; i < num; ++i) {
+						new(dst.data + dst.count + i) T(elems[i]);
+					}
+				}
+
+				dst.count += num;
+				return true;
+			}
+
+			/**
+			 * Add the elements in [`first`, `last`) at the end of the array.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to add the elements to
+			 * @param first First element to add
+			 * @param last One past the last element to add
+			 * @return true if successful, false otherwise
+			 * @see push_n()
+			 */
+			template <typename T, typename A>
+			inline types::boolean append_range(dynamic<T, A>& dst,
+				const T* first, const T* last) {
+				angie_assert(first <= last);
+				return push_n(dst, first, static_cast<types::size>(last - first));
+			}
+
+			/**
+			 * Add one element at the end of an array with room for it.
+			 *
+			 * No check is made at all, the caller must have reserved enough
+			 * space beforehand, i.e. through `reserve()`.
+			 *
+			 * @tparam T POD type
+			 * @tparam A Allocator policy
+			 * @param dst Array to add the element to
+			 * @return The new element, default initialized, which leaves
+			 *         trivial types uninitialized
+			 */
+			template <typename T, typename A>
+			inline T& emplace_back_unchecked(dynamic<T, A>& dst) {
+				angie_assert(dst.count < dst.capacity);
+				return *new(dst.data + dst.count++) T;
+			}
+
+			/**
+			 * Construct one element at the end of an array with room for it.
+			 *
+			 * @tparam T Element type
+			 * @tparam A Allocator policy
+			 * @tparam Args Types of the constructor arguments
+			 * @param dst Array to add the element to
+			 * @param first First constructor argument
+			 * @param args Other constructor arguments
+			 * @return The new element
+			 * @see emplace_back_unchecked()
+			 */
+			template <typename T, typename A, typename U, typename... Args>
+			inline T& emplace_back_unchecked(dynamic<T, A>& dst, U&& first,
+				Args&&... args) {
+				angie_assert(dst.count < dst.capacity);
+				return *new(dst.data + dst.count++) T(std::forward<U>(first),
+					std::forward<Args>(args)...);
+			}
+
 			/**
 			 * Remove one element from the end of the array.
 			 *
 			 * If the function fails, the given variable will be left untouched.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param dst Source array to add the element to
 			 * @param elem Variable that will hold the element removed
 			 * @return true if the element has been successfully removed to the
 			 *         array, false otherwise.
 			 */
-			template <typename T>
-			inline types::boolean pop(dynamic<T>& dst, T& elem) {
+			template <typename T, typename A>
+			inline types::boolean pop(dynamic<T, A>& dst, T& elem) {
 				angie_assert(is_valid(dst));
 
-				if (const auto count = get_count(dst) > 0) {
-					elem = at(dst, count - 1);
-					--dst.count;
+				if (dst.count > 0) {
+					elem = std::move(dst.data[--dst.count]);
+					destroy_n(dst.data + dst.count, 1);
 					return true;
 				}
 
@@ -976,18 +1789,20 @@ namespace angie {
 			 * Make a new copy of the source array.
 			 *
 			 * @tparam T POD type
+			 * @tparam A Allocator policy
 			 * @param src Source array to copy elements from
 			 * @param new_allocator Allocator used to make the new array
 			 * @return A new array if we successfully create and copied the
 			 *         elements over from the source array, nullptr otherwise.
 			 */
-			template <typename T>
-			inline dynamic<T>* make_copy(const dynamic<T>& src,
+			template <typename T, typename A>
+			inline dynamic<T, A>* make_copy(const dynamic<T, A>& src,
 				const memory::allocator* new_allocator =
-					memory::get_default_allocator()) {
+					A::get_allocator()) {
 				angie_assert(is_valid(src));
 
-				if (auto* new_array = make<T>(src.count, new_allocator)) {
+				if (auto* new_array = make<T, A>(src.count, new_allocator,
+						src.grow, src.chunk, src.align)) {
 					if (copy(*new_array, src)) {
 						return new_array;
 					}
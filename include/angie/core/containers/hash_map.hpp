@@ -0,0 +1,686 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <functional> // std::hash
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+	|| (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ANGIE_HASH_MAP_SSE2
+#endif
+
+#include "angie/core/types.hpp"
+#include "angie/core/utils.hpp"
+#include "angie/core/memory/allocator.hpp"
+#include "angie/core/memory/manipulation.hpp"
+#include "angie/core/containers/dynamic_array.hpp"
+#include "angie/core/debug/assert.hpp"
+
+namespace angie {
+	namespace core {
+		namespace map {
+
+			/**
+			 * Number of control bytes probed at once.
+			 */
+			constexpr types::size group_width = 16;
+
+			/**
+			 * Control byte of a slot never used, or usable again.
+			 */
+			constexpr types::int8 ctrl_empty = -128;
+
+			/**
+			 * Control byte of an erased slot a probe may have passed through.
+			 */
+			constexpr types::int8 ctrl_deleted = -2;
+
+			/**
+			 * Slot returned when a key is not found.
+			 */
+			constexpr types::size none = SIZE_MAX;
+
+			/**
+			 * Key and value pair held by every used slot.
+			 */
+			template <typename K, typename V>
+			struct entry {
+				K	key;
+				V	value;
+			};
+
+			/**
+			 * Spread the bits of the given hash value.
+			 *
+			 * Control bytes store the lowest 7 bits, and the probe starts
+			 * from the other ones, so they all need to look random, which
+			 * is not the case for many hash functions, i.e. identity ones.
+			 *
+			 * @param h Hash value
+			 * @return Mixed hash value
+			 */
+			inline types::size mix(types::size h) {
+#ifdef ANGIE_ARCH_64
+				h ^= h >> 33;
+				h *= 0xff51afd7ed558ccdull;
+				h ^= h >> 33;
+				h *= 0xc4ceb9fe1a85ec53ull;
+				h ^= h >> 33;
+#else
+				h ^= h >> 16;
+				h *= 0x85ebca6bu;
+				h ^= h >> 13;
+				h *= 0xc2b2ae35u;
+				h ^= h >> 16;
+#endif
+				return h;
+			}
+
+			/**
+			 * Default hash function, std::hash mixed.
+			 *
+			 * @tparam K Key type
+			 */
+			template <typename K>
+			struct hash {
+				types::size operator()(const K& key) const {
+					return mix(std::hash<K>()(key));
+				}
+			};
+
+			namespace group {
+
+				/**
+				 * Slots in the group, whose control byte is `h2`.
+				 *
+				 * @param ctrl First control byte of the group
+				 * @param h2 Lowest 7 bits of the hash
+				 * @return One bit per matching slot, in the group order
+				 */
+				inline types::uint32 match(const types::int8* ctrl,
+					types::int8 h2) {
+#ifdef ANGIE_HASH_MAP_SSE2
+					const __m128i g = _mm_loadu_si128(
+						reinterpret_cast<const __m128i*>(ctrl));
+					return static_cast<types::uint32>(_mm_movemask_epi8(
+						_mm_cmpeq_epi8(_mm_set1_epi8(h2), g)));
+#else
+					types::uint32 bits = 0;
+					for (types::uint32 i = 0; i < group_width; ++i) {
+						bits |= types::uint32(ctrl[i] == h2) << i;
+					}
+					return bits;
+#endif
+				}
+
+				/**
+				 * Slots in the group never used.
+				 */
+				inline types::uint32 match_empty(const types::int8* ctrl) {
+					return match(ctrl, ctrl_empty);
+				}
+
+				/**
+				 * Slots in the group that can take a new entry.
+				 */
+				inline types::uint32 match_free(const types::int8* ctrl) {
+#ifdef ANGIE_HASH_MAP_SSE2
+					// Empty and deleted are the only negative control bytes
+					return static_cast<types::uint32>(_mm_movemask_epi8(
+						_mm_loadu_si128(
+							reinterpret_cast<const __m128i*>(ctrl))));
+#else
+					types::uint32 bits = 0;
+					for (types::uint32 i = 0; i < group_width; ++i) {
+						bits |= types::uint32(ctrl[i] < 0) << i;
+					}
+					return bits;
+#endif
+				}
+
+				/**
+				 * Position of the first slot in the mask.
+				 */
+				inline types::uint32 first(types::uint32 bits) {
+					angie_assert(bits);
+					types::uint32 r = 0;
+					angie_bsf(r, bits);
+					return r;
+				}
+
+				/**
+				 * Number of slots after the last one in the mask.
+				 */
+				inline types::uint32 leading(types::uint32 bits) {
+					angie_assert(bits);
+					types::uint32 r = 0;
+					angie_bsr(r, bits);
+					return group_width - 1 - r;
+				}
+
+			}
+
+			/**
+			 * Flat hash map, Swiss table style.
+			 *
+			 * Keys and values live in one array of slots, along with one
+			 * control byte per slot, telling whether it is empty, erased, or
+			 * holding an entry, in which case it stores 7 bits of its hash.
+			 * Lookups compare 16 control bytes at once, only touching slots
+			 * whose hash bits match, so that they rarely take more than one
+			 * cache miss, even when the table is 7/8 full.
+			 * Erasing doesn't leave a tombstone behind, unless a probe may have
+			 * passed through the slot, which happens only in groups that were
+			 * full. Those are dropped once the table is rehashed.
+			 * The map is initialised and released like arrays are, and the
+			 * same allocator policies apply.
+			 *
+			 * @tparam K Key type, comparable with ==
+			 * @tparam V Value type, default constructible
+			 * @tparam H Hash function object
+			 * @tparam A Allocator policy, i.e. `array::global_allocator`
+			 */
+			template <typename K, typename V, typename H = hash<K>,
+				typename A = array::runtime_allocator>
+			struct flat {
+				types::int8*				ctrl;
+				entry<K, V>*				slots;
+				types::size					count;
+				types::size					capacity;
+				types::size					growth_left;
+				const memory::allocator*	ator;
+			};
+
+			/**
+			 * Maximum number of entries for the given capacity.
+			 */
+			constexpr inline types::size compute_growth(types::size capacity) {
+				return capacity - capacity / 8;
+			}
+
+			/**
+			 * Smallest capacity holding the given number of entries.
+			 *
+			 * @param num Number of entries
+			 * @return Power of two capacity, not less than the group width
+			 */
+			inline types::size compute_capacity(types::size num) {
+				types::size capacity = group_width;
+				while (compute_growth(capacity) < num) {
+					capacity <<= 1;
+				}
+
+				return capacity;
+			}
+
+			/**
+			 * Offset of the slots from the control bytes, in bytes.
+			 *
+			 * Control bytes of the first group are cloned after the last
+			 * slot, so that groups can be loaded at any position.
+			 */
+			template <typename K, typename V>
+			constexpr inline types::size compute_slots_offset(
+				types::size capacity) {
+				return (capacity + group_width - 1 + alignof(entry<K, V>) - 1)
+					& ~(alignof(entry<K, V>) - 1);
+			}
+
+			/**
+			 * Size in bytes of the memory block of the map.
+			 */
+			template <typename K, typename V>
+			constexpr inline types::size compute_size(types::size capacity) {
+				return compute_slots_offset<K, V>(capacity)
+					+ capacity * sizeof(entry<K, V>);
+			}
+
+			/**
+			 * Alignment of the memory block of the map.
+			 */
+			template <typename K, typename V>
+			constexpr inline types::size get_align() {
+				return alignof(entry<K, V>) > ANGIE_DEFAULT_MEMORY_ALIGNMENT
+					? alignof(entry<K, V>) : ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+			}
+
+			/**
+			 * Get the number of entries in the map.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::size get_count(const flat<K, V, H, A>& m) {
+				return m.count;
+			}
+
+			/**
+			 * Get the number of slots of the map.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::size get_capacity(const flat<K, V, H, A>& m) {
+				return m.capacity;
+			}
+
+			/**
+			 * Whether the map has no entries.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean is_empty(const flat<K, V, H, A>& m) {
+				return m.count == 0;
+			}
+
+			/**
+			 * Set the control byte of a slot, and of its clone, if any.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline void set_ctrl(flat<K, V, H, A>& m, types::size i,
+				types::int8 c) {
+				m.ctrl[i] = c;
+				if (i < group_width - 1) {
+					m.ctrl[m.capacity + i] = c;
+				}
+			}
+
+			/**
+			 * Find the slot of the given key.
+			 *
+			 * @param m Map to search
+			 * @param key Key to find
+			 * @param h Hash of the key
+			 * @return Slot of the key, `none` if not found
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::size find_slot(const flat<K, V, H, A>& m,
+				const K& key, types::size h) {
+				if (!m.capacity) {
+					return none;
+				}
+
+				const auto mask = m.capacity - 1;
+				const auto h2 = static_cast<types::int8>(h & 0x7f);
+				auto pos = (h >> 7) & mask;
+
+				// Quadratic probe over groups, visiting all of them
+				for (types::size step = group_width;; step += group_width) {
+					const types::int8* g = m.ctrl + pos;
+					for (auto bits = group::match(g, h2); bits;
+						bits &= bits - 1) {
+						const auto i = (pos + group::first(bits)) & mask;
+						if (angie_likely(m.slots[i].key == key)) {
+							return i;
+						}
+					}
+
+					// Insertion would have stopped here
+					if (angie_likely(group::match_empty(g))) {
+						return none;
+					}
+
+					pos = (pos + step) & mask;
+				}
+			}
+
+			/**
+			 * Find the first slot that can take the given hash.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::size find_free_slot(const flat<K, V, H, A>& m,
+				types::size h) {
+				angie_assert(m.capacity && m.count < m.capacity);
+
+				const auto mask = m.capacity - 1;
+				auto pos = (h >> 7) & mask;
+
+				for (types::size step = group_width;; step += group_width) {
+					if (auto bits = group::match_free(m.ctrl + pos)) {
+						return (pos + group::first(bits)) & mask;
+					}
+
+					pos = (pos + step) & mask;
+				}
+			}
+
+			/**
+			 * Move all the entries to a new table of the given capacity.
+			 *
+			 * Tombstones are not carried over.
+			 *
+			 * @param m Map to rehash
+			 * @param new_capacity Power of two, holding all the entries
+			 * @return true if successful, false otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean rehash(flat<K, V, H, A>& m,
+				types::size new_capacity) {
+				angie_assert(utils::is_power_of_two(new_capacity));
+				angie_assert(compute_growth(new_capacity) >= m.count);
+
+				auto* block = static_cast<types::byte*>(A::alloc(m.ator,
+					compute_size<K, V>(new_capacity), get_align<K, V>()));
+
+				// Allocation might fail
+				if (!block) {
+					return false;
+				}
+
+				flat<K, V, H, A> n = {
+					reinterpret_cast<types::int8*>(block),
+					reinterpret_cast<entry<K, V>*>(block
+						+ compute_slots_offset<K, V>(new_capacity)),
+					m.count, new_capacity,
+					compute_growth(new_capacity) - m.count, m.ator
+				};
+
+				memory::set(n.ctrl, static_cast<types::byte>(ctrl_empty),
+					new_capacity + group_width - 1);
+
+				for (types::size i = 0; i < m.capacity; ++i) {
+					if (m.ctrl[i] >= 0) {
+						auto& e = m.slots[i];
+						const auto h = H()(e.key);
+						const auto j = find_free_slot(n, h);
+
+						set_ctrl(n, j, static_cast<types::int8>(h & 0x7f));
+						new(n.slots + j) entry<K, V> {
+							std::move(e.key), std::move(e.value)
+						};
+						e.~entry<K, V>();
+					}
+				}
+
+				if (m.ctrl) {
+					A::dealloc(m.ator, m.ctrl, compute_size<K, V>(m.capacity));
+				}
+
+				m = n;
+				return true;
+			}
+
+			/**
+			 * Make room for `num` entries in total.
+			 *
+			 * @param m Map to grow
+			 * @param num Number of entries the map must hold
+			 * @return true if successful, false otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean reserve(flat<K, V, H, A>& m,
+				types::size num) {
+				if (num <= m.count + m.growth_left) {
+					return true;
+				}
+
+				return m.ator && rehash(m, compute_capacity(num));
+			}
+
+			/**
+			 * Initialise the given map.
+			 *
+			 * @param m Map to initialise
+			 * @param num Number of entries to make room for
+			 * @param alloc_to_use Allocator of the map memory
+			 * @return true if successful, false otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean init(flat<K, V, H, A>& m,
+				types::size num = 0,
+				const memory::allocator* alloc_to_use =
+					A::get_allocator()) {
+				angie_assert(is_empty(m));
+				if (m.ator == nullptr) {
+					m.ator = alloc_to_use;
+				}
+
+				return reserve(m, num);
+			}
+
+			/**
+			 * Remove all the entries, keeping the memory.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline void clear(flat<K, V, H, A>& m) {
+				if (!m.capacity) {
+					return;
+				}
+
+				for (types::size i = 0; i < m.capacity; ++i) {
+					if (m.ctrl[i] >= 0) {
+						m.slots[i].~entry<K, V>();
+					}
+				}
+
+				memory::set(m.ctrl, static_cast<types::byte>(ctrl_empty),
+					m.capacity + group_width - 1);
+				m.count = 0;
+				m.growth_left = compute_growth(m.capacity);
+			}
+
+			/**
+			 * Remove all the entries, and release the memory.
+			 *
+			 * The allocator is kept, the map can be used again.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline void release(flat<K, V, H, A>& m) {
+				clear(m);
+
+				if (m.ctrl) {
+					A::dealloc(m.ator, m.ctrl, compute_size<K, V>(m.capacity));
+				}
+
+				m.ctrl = nullptr;
+				m.slots = nullptr;
+				m.capacity = 0;
+				m.growth_left = 0;
+			}
+
+			/**
+			 * Instantiate a new map object.
+			 *
+			 * @param num Number of entries to make room for
+			 * @param alloc_to_use Allocator of the map, and its memory
+			 * @return Not null object on success, nullptr otherwise
+			 */
+			template <typename K, typename V, typename H = hash<K>,
+				typename A = array::runtime_allocator>
+			inline flat<K, V, H, A>* make(types::size num = 0,
+				const memory::allocator* alloc_to_use =
+					A::get_allocator()) {
+				auto* buffer = A::alloc(alloc_to_use,
+					sizeof(flat<K, V, H, A>), alignof(flat<K, V, H, A>));
+
+				// Memory allocation can fail
+				if (!buffer) {
+					return nullptr;
+				}
+
+				auto* m = new(buffer) flat<K, V, H, A> {
+					nullptr, nullptr, 0, 0, 0, alloc_to_use
+				};
+
+				if (!reserve(*m, num)) {
+					A::dealloc(alloc_to_use, buffer, sizeof(*m));
+					return nullptr;
+				}
+
+				return m;
+			}
+
+			/**
+			 * Release and destroy the given map.
+			 *
+			 * @param m Map made by `make()`, it will be set to null
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline void destroy(flat<K, V, H, A>*& m) {
+				if (m) {
+					auto* allocator = m->ator;
+					release(*m);
+					A::dealloc(allocator, m, sizeof(*m));
+					m = nullptr;
+				}
+			}
+
+			/**
+			 * Find the value of the given key.
+			 *
+			 * @return The value if found, nullptr otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline V* find(flat<K, V, H, A>& m, const K& key) {
+				const auto i = find_slot(m, key, H()(key));
+				return i != none ? &m.slots[i].value : nullptr;
+			}
+
+			/**
+			 * Find the value of the given key.
+			 *
+			 * @return The value if found, nullptr otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline const V* find(const flat<K, V, H, A>& m, const K& key) {
+				const auto i = find_slot(m, key, H()(key));
+				return i != none ? &m.slots[i].value : nullptr;
+			}
+
+			/**
+			 * Whether the map holds the given key.
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean contains(const flat<K, V, H, A>& m,
+				const K& key) {
+				return find_slot(m, key, H()(key)) != none;
+			}
+
+			/**
+			 * Find the value of the given key, adding it if not found.
+			 *
+			 * New values are default constructed. Adding entries may move
+			 * the others, invalidating pointers to their values.
+			 *
+			 * @param m Map to search
+			 * @param key Key to find
+			 * @return The value of the key, nullptr if it couldn't be added
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline V* find_or_add(flat<K, V, H, A>& m, const K& key) {
+				const auto h = H()(key);
+				auto i = find_slot(m, key, h);
+				if (i != none) {
+					return &m.slots[i].value;
+				}
+
+				// No allocator no party
+				if (!m.ator) {
+					return nullptr;
+				}
+
+				if (m.capacity) {
+					i = find_free_slot(m, h);
+				}
+
+				// Reusing a tombstone doesn't need any room
+				if (!m.capacity || (!m.growth_left
+					&& m.ctrl[i] != ctrl_deleted)) {
+					// Under 25/32 full, dropping tombstones makes enough room
+					const auto new_capacity = !m.capacity ? group_width
+						: m.count * 32 <= m.capacity * 25
+						? m.capacity : m.capacity << 1;
+
+					if (!rehash(m, new_capacity)) {
+						return nullptr;
+					}
+
+					i = find_free_slot(m, h);
+				}
+
+				m.growth_left -= m.ctrl[i] == ctrl_empty;
+				set_ctrl(m, i, static_cast<types::int8>(h & 0x7f));
+				new(m.slots + i) entry<K, V> { key, V() };
+				++m.count;
+
+				return &m.slots[i].value;
+			}
+
+			/**
+			 * Add, or overwrite, the value of the given key.
+			 *
+			 * @param m Map to add the entry to
+			 * @param key Key of the entry
+			 * @param value Value of the entry
+			 * @return The value stored, nullptr if it couldn't be added
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline V* insert(flat<K, V, H, A>& m, const K& key, V value) {
+				auto* v = find_or_add(m, key);
+				if (v) {
+					*v = std::move(value);
+				}
+
+				return v;
+			}
+
+			/**
+			 * Remove the entry of the given key.
+			 *
+			 * The slot becomes empty again, unless it sits in a run of
+			 * 16 slots, or more, which were all taken, as some probe may have
+			 * skipped past it, and then it is marked as erased.
+			 *
+			 * @param m Map to remove the entry from
+			 * @param key Key of the entry
+			 * @return true if the entry was found, false otherwise
+			 */
+			template <typename K, typename V, typename H, typename A>
+			inline types::boolean erase(flat<K, V, H, A>& m, const K& key) {
+				const auto i = find_slot(m, key, H()(key));
+				if (i == none) {
+					return false;
+				}
+
+				m.slots[i].~entry<K, V>();
+				--m.count;
+
+				const auto before = (i - group_width) & (m.capacity - 1);
+				const auto empty_after = group::match_empty(m.ctrl + i);
+				const auto empty_before = group::match_empty(m.ctrl + before);
+
+				// Any group covering the slot had an empty one
+				const bool never_full = empty_before && empty_after
+					&& group::first(empty_after)
+						+ group::leading(empty_before) < group_width;
+
+				set_ctrl(m, i, never_full ? ctrl_empty : ctrl_deleted);
+				m.growth_left += never_full;
+				return true;
+			}
+
+			/**
+			 * Visit all the entries of the map, in no particular order.
+			 *
+			 * Entries can't be added, nor removed, from the visitor.
+			 *
+			 * @tparam F Callable as `void (const K&, V&)`
+			 * @param m Map to visit
+			 * @param visit Function called once per entry
+			 */
+			template <typename K, typename V, typename H, typename A,
+				typename F>
+			inline void for_each(flat<K, V, H, A>& m, F visit) {
+				for (types::size i = 0; i < m.capacity; ++i) {
+					if (m.ctrl[i] >= 0) {
+						visit(static_cast<const K&>(m.slots[i].key),
+							m.slots[i].value);
+					}
+				}
+			}
+
+		}
+	}
+}
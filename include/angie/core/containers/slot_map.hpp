@@ -0,0 +1,346 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+#include "angie/core/containers/dynamic_array.hpp"
+
+namespace angie {
+	namespace core {
+		namespace slot {
+
+			/**
+			 * Reference to an element of a slot map.
+			 *
+			 * Two 16 bits fields make a 32 bits handle, two 32 bits ones
+			 * make a 64 bits handle.
+			 *
+			 * @tparam I Unsigned integer type of the fields
+			 */
+			template <typename I = types::uint32>
+			struct handle {
+				I	index;
+				I	generation;
+			};
+
+			/**
+			 * Indirection from a handle to the element.
+			 *
+			 * Live slots have an odd generation, and hold the position of
+			 * their element, free ones have an even generation, and hold the
+			 * next free slot. The generation increases on insert and erase.
+			 */
+			template <typename I>
+			struct entry {
+				I	index;
+				I	generation;
+			};
+
+			/**
+			 * Generational slot map.
+			 *
+			 * Elements are packed in a dense array, in no particular order,
+			 * and referred to by handles, which stay valid until the element
+			 * is erased, as they go through an array of slots. Erasing moves
+			 * the last element in place of the erased one, so the data stays
+			 * contiguous, and iterating it is a linear walk. Slots are reused,
+			 * but their generation changes, so stale handles are detected,
+			 * until a slot has been reused 2^(bits - 1) times.
+			 * The map must be zero initialised and `init()`-ed before use.
+			 *
+			 * @tparam T Element type
+			 * @tparam I Handle fields type, `types::uint16` for 32 bits handles
+			 * @tparam A Allocator policy
+			 * @param data Elements, densely packed
+			 * @param owners Slot of each element
+			 * @param slots Element position, or next free slot, of each slot
+			 * @param free_head First free slot, `none<I>()` if there is none
+			 */
+			template <typename T, typename I = types::uint32,
+				typename A = array::runtime_allocator>
+			struct map {
+				static_assert(std::is_unsigned<I>::value,
+					"Handle fields must be unsigned integers");
+
+				array::dynamic<T, A>			data;
+				array::dynamic<I, A>			owners;
+				array::dynamic<entry<I>, A>		slots;
+				I								free_head;
+			};
+
+			/**
+			 * Index of no slot, the map holds fewer elements than that.
+			 */
+			template <typename I>
+			constexpr inline I none() {
+				return std::numeric_limits<I>::max();
+			}
+
+			/**
+			 * Handle referring to no element.
+			 */
+			template <typename I = types::uint32>
+			constexpr inline handle<I> null_handle() {
+				return { none<I>(), 0 };
+			}
+
+			/**
+			 * Get the number of elements in the map.
+			 */
+			template <typename T, typename I, typename A>
+			inline types::size get_count(const map<T, I, A>& m) {
+				return m.data.count;
+			}
+
+			/**
+			 * Whether the map has no elements.
+			 */
+			template <typename T, typename I, typename A>
+			inline types::boolean is_empty(const map<T, I, A>& m) {
+				return m.data.count == 0;
+			}
+
+			/**
+			 * Get the elements, packed from 0 to `get_count()`.
+			 */
+			template <typename T, typename I, typename A>
+			inline T* get_data(map<T, I, A>& m) {
+				return m.data.data;
+			}
+
+			/**
+			 * Make room for `num` more elements.
+			 *
+			 * @return true if successful, false otherwise
+			 */
+			template <typename T, typename I, typename A>
+			inline types::boolean reserve(map<T, I, A>& m, types::size num) {
+				return array::reserve(m.data, num)
+					&& array::reserve(m.owners, num)
+					&& array::reserve(m.slots, num);
+			}
+
+			/**
+			 * Initialise the given map.
+			 *
+			 * @param m Zero initialised map
+			 * @param num Number of elements to make room for
+			 * @param alloc_to_use Allocator of the map memory
+			 * @return true if successful, false otherwise
+			 */
+			template <typename T, typename I, typename A>
+			inline types::boolean init(map<T, I, A>& m, types::size num = 0,
+				const memory::allocator* alloc_to_use =
+					A::get_allocator()) {
+				m.free_head = none<I>();
+				return array::init(m.data, 0, alloc_to_use)
+					&& array::init(m.owners, 0, alloc_to_use)
+					&& array::init(m.slots, 0, alloc_to_use)
+					&& reserve(m, num);
+			}
+
+			/**
+			 * Erase all the elements, keeping the memory.
+			 *
+			 * Handles to the erased elements become stale.
+			 */
+			template <typename T, typename I, typename A>
+			inline void clear(map<T, I, A>& m) {
+				for (types::size i = 0; i < m.owners.count; ++i) {
+					const auto s = m.owners.data[i];
+					auto& e = m.slots.data[s];
+					++e.generation;
+					e.index = m.free_head;
+					m.free_head = s;
+				}
+
+				array::clear(m.data, m.data.count);
+				array::clear(m.owners, m.owners.count);
+			}
+
+			/**
+			 * Erase all the elements, and release the memory.
+			 *
+			 * Generations are lost, handles taken before this call must
+			 * not be used with the map anymore.
+			 */
+			template <typename T, typename I, typename A>
+			inline void release(map<T, I, A>& m) {
+				array::release(m.data);
+				array::release(m.owners);
+				array::release(m.slots);
+				m.free_head = none<I>();
+			}
+
+			/**
+			 * Instantiate a new map object.
+			 *
+			 * @param num Number of elements to make room for
+			 * @param alloc_to_use Allocator of the map, and its memory
+			 * @return Not null object on success, nullptr otherwise
+			 */
+			template <typename T, typename I = types::uint32,
+				typename A = array::runtime_allocator>
+			inline map<T, I, A>* make(types::size num = 0,
+				const memory::allocator* alloc_to_use =
+					A::get_allocator()) {
+				auto* buffer = A::alloc(alloc_to_use,
+					sizeof(map<T, I, A>), alignof(map<T, I, A>));
+
+				// Memory allocation can fail
+				if (!buffer) {
+					return nullptr;
+				}
+
+				auto* m = new(buffer) map<T, I, A> {};
+				if (!init(*m, num, alloc_to_use)) {
+					release(*m);
+					A::dealloc(alloc_to_use, buffer, sizeof(*m));
+					return nullptr;
+				}
+
+				return m;
+			}
+
+			/**
+			 * Release and destroy the given map.
+			 *
+			 * @param m Map made by `make()`, it will be set to null
+			 */
+			template <typename T, typename I, typename A>
+			inline void destroy(map<T, I, A>*& m) {
+				if (m) {
+					auto* allocator = m->data.ator;
+					release(*m);
+					A::dealloc(allocator, m, sizeof(*m));
+					m = nullptr;
+				}
+			}
+
+			/**
+			 * Whether the handle refers to an element of the map.
+			 */
+			template <typename T, typename I, typename A>
+			inline types::boolean contains(const map<T, I, A>& m,
+				handle<I> h) {
+				return h.index < m.slots.count && (h.generation & 1)
+					&& m.slots.data[h.index].generation == h.generation;
+			}
+
+			/**
+			 * Get the element referred to by the handle.
+			 *
+			 * @return The element, nullptr if the handle is stale
+			 */
+			template <typename T, typename I, typename A>
+			inline T* get(map<T, I, A>& m, handle<I> h) {
+				return contains(m, h)
+					? m.data.data + m.slots.data[h.index].index : nullptr;
+			}
+
+			/**
+			 * Get the element referred to by the handle.
+			 *
+			 * @return The element, nullptr if the handle is stale
+			 */
+			template <typename T, typename I, typename A>
+			inline const T* get(const map<T, I, A>& m, handle<I> h) {
+				return contains(m, h)
+					? m.data.data + m.slots.data[h.index].index : nullptr;
+			}
+
+			/**
+			 * Get the handle of the element at the given position.
+			 *
+			 * @param m Map to query
+			 * @param at Position of the element, less than `get_count()`
+			 * @return Handle of the element
+			 */
+			template <typename T, typename I, typename A>
+			inline handle<I> get_handle(const map<T, I, A>& m,
+				types::size at) {
+				angie_assert(at < m.data.count);
+				const auto s = m.owners.data[at];
+				return { s, m.slots.data[s].generation };
+			}
+
+			/**
+			 * Add an element to the map.
+			 *
+			 * The element goes at the end of the data, and pointers to the
+			 * others may be invalidated, while their handles are not.
+			 *
+			 * @param m Map to add the element to
+			 * @param value Element to add
+			 * @return Handle of the element, `null_handle()` on failure
+			 */
+			template <typename T, typename I, typename A>
+			inline handle<I> insert(map<T, I, A>& m, T value) {
+				const auto at = m.data.count;
+
+				// Every element needs a slot, and `none()` isn't one
+				if (at >= none<I>() || !array::reserve(m.data, 1)
+					|| !array::reserve(m.owners, 1)
+					|| (m.free_head == none<I>()
+						&& !array::reserve(m.slots, 1))) {
+					return null_handle<I>();
+				}
+
+				auto s = m.free_head;
+				if (s != none<I>()) {
+					m.free_head = m.slots.data[s].index;
+				}
+				else {
+					s = static_cast<I>(m.slots.count);
+					array::emplace_back_unchecked(m.slots, entry<I> { 0, 0 });
+				}
+
+				array::emplace_back_unchecked(m.data, std::move(value));
+				array::emplace_back_unchecked(m.owners, s);
+
+				auto& e = m.slots.data[s];
+				e.index = static_cast<I>(at);
+				return { s, ++e.generation };
+			}
+
+			/**
+			 * Erase the element referred to by the handle.
+			 *
+			 * The last element takes its place, keeping its own handle.
+			 *
+			 * @param m Map to erase the element from
+			 * @param h Handle of the element
+			 * @return true if the element was found, false otherwise
+			 */
+			template <typename T, typename I, typename A>
+			inline types::boolean erase(map<T, I, A>& m, handle<I> h) {
+				if (!contains(m, h)) {
+					return false;
+				}
+
+				auto& e = m.slots.data[h.index];
+				const auto at = e.index;
+
+				array::replace_with_last(m.data, at, 1);
+				array::replace_with_last(m.owners, at, 1);
+
+				// The last element moved, its slot must follow
+				if (at < m.owners.count) {
+					m.slots.data[m.owners.data[at]].index = at;
+				}
+
+				++e.generation;
+				e.index = m.free_head;
+				m.free_head = h.index;
+				return true;
+			}
+
+		}
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/containers/dynamic_array.hpp"
+
+namespace angie {
+	namespace core {
+		namespace array {
+
+			/**
+			 * Dynamic array holding up to `N` elements in place.
+			 *
+			 * It is a `dynamic` array, whose data starts borrowed from the
+			 * inline buffer, so all the functions operating on those work
+			 * on this one too. No memory is requested until the array grows
+			 * past `N` elements, when they move to memory requested to the
+			 * allocator. `fit()` and `release()` bring them back in place.
+			 * The array is ready to use once constructed, there is no need
+			 * to `init()` it, and it can't be copied, because its data may
+			 * point to itself, use `copy()` instead. Elements are destroyed,
+			 * and memory released, when it goes out of scope.
+			 *
+			 * @tparam T Element type
+			 * @tparam N Number of elements stored in place
+			 * @tparam A Allocator policy
+			 */
+			template <typename T, types::size N, typename A = runtime_allocator>
+			struct small : dynamic<T, A> {
+				static_assert(N > 0, "Inline capacity can't be zero");
+
+				explicit small(const memory::allocator* alloc_to_use =
+					A::get_allocator())
+					: dynamic<T, A> {
+						reinterpret_cast<T*>(storage), 0, N, alloc_to_use,
+						growth::power_of_two, true, 0, 0
+					} {
+				}
+
+				~small() {
+					release(static_cast<dynamic<T, A>&>(*this));
+				}
+
+				small(const small&) = delete;
+				small& operator=(const small&) = delete;
+
+				alignas(T) types::byte storage[sizeof(T) * N];
+			};
+
+			/**
+			 * Get the inline buffer of the array.
+			 *
+			 * @tparam T Element type
+			 * @tparam N Number of elements stored in place
+			 * @tparam A Allocator policy
+			 * @param arr Array object to query
+			 * @return Memory for `N` elements, within the array object
+			 */
+			template <typename T, types::size N, typename A>
+			inline T* get_inline_data(small<T, N, A>& arr) {
+				return reinterpret_cast<T*>(arr.storage);
+			}
+
+			/**
+			 * Whether the elements are stored in place.
+			 *
+			 * @tparam T Element type
+			 * @tparam N Number of elements stored in place
+			 * @tparam A Allocator policy
+			 * @param arr Array object to query
+			 * @return true if no memory is held, false otherwise
+			 */
+			template <typename T, types::size N, typename A>
+			inline types::boolean is_inline(const small<T, N, A>& arr) {
+				return arr.data == reinterpret_cast<const T*>(arr.storage);
+			}
+
+			/**
+			 * Release memory, and store elements in place again.
+			 *
+			 * @tparam T Element type
+			 * @tparam N Number of elements stored in place
+			 * @tparam A Allocator policy
+			 * @param arr Array to empty
+			 */
+			template <typename T, types::size N, typename A>
+			inline void release(small<T, N, A>& arr) {
+				release(static_cast<dynamic<T, A>&>(arr));
+
+				if (!arr.data) {
+					arr.data = get_inline_data(arr);
+					arr.capacity = N;
+					arr.borrowed = true;
+				}
+			}
+
+			/**
+			 * Reallocate memory to best fit the required data count.
+			 *
+			 * Elements move back in place, as soon as there is room for them,
+			 * and the data alignment allows for it.
+			 *
+			 * @tparam T Element type
+			 * @tparam N Number of elements stored in place
+			 * @tparam A Allocator policy
+			 * @param dst Array to operate on
+			 * @return true if successful, false otherwise
+			 */
+			template <typename T, types::size N, typename A>
+			inline types::boolean fit(small<T, N, A>& dst) {
+				angie_assert(is_valid(dst));
+
+				auto* inline_data = get_inline_data(dst);
+				if (dst.borrowed || dst.count > N || !utils::is_multiple_of(
+						(types::uintptr)inline_data, get_align(dst))) {
+					return fit(static_cast<dynamic<T, A>&>(dst));
+				}
+
+				if (dst.data) {
+					relocate_n(inline_data, dst.data, dst.count);
+					A::dealloc(dst.ator, dst.data,
+						compute_size<T>(dst.capacity));
+				}
+
+				dst.data = inline_data;
+				dst.capacity = N;
+				dst.borrowed = true;
+				return true;
+			}
+
+		}
+	}
+}
@@ -0,0 +1,438 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "angie/core/containers/dynamic_array.hpp"
+
+namespace angie {
+	namespace core {
+		namespace array {
+
+			/**
+			 * Whether all the given types are trivially copyable.
+			 */
+			template <typename... Ts>
+			struct all_trivially_copyable : std::true_type {};
+
+			template <typename T, typename... Ts>
+			struct all_trivially_copyable<T, Ts...>
+				: std::integral_constant<bool,
+					std::is_trivially_copyable<T>::value
+					&& all_trivially_copyable<Ts...>::value> {};
+
+			/**
+			 * Dynamic structure of arrays.
+			 *
+			 * Every field `Ts` gets its own column, so that loops touching a
+			 * few fields only read those, and can process them with aligned
+			 * vector loads. Columns live in a single block of memory, one after
+			 * the other, each aligned to `align`, and they all hold `capacity`
+			 * elements, growing together, according to the same policies of
+			 * `dynamic` arrays. Fields are moved around as raw memory.
+			 * The array must be zero initialised and `init()`-ed before use,
+			 * unless made with `make_soa()`.
+			 *
+			 * @tparam Ts Field types, trivially copyable
+			 * @param columns First element of every column
+			 * @param align Alignment of the columns, zero for `simd_align`
+			 * @param block_align Alignment the columns were allocated with
+			 */
+			template <typename... Ts>
+			struct soa {
+				static_assert(sizeof...(Ts) > 0,
+					"Arrays need one field at least");
+				static_assert(all_trivially_copyable<Ts...>::value,
+					"Fields must be trivially copyable");
+
+				void*						columns[sizeof...(Ts)];
+				types::size					count;
+				types::size					capacity;
+				const memory::allocator*	ator;
+				growth						grow;
+				types::uint16				align;
+				types::uint16				block_align;
+				types::uint32				chunk;
+			};
+
+			/**
+			 * Type of the `I`-th field.
+			 */
+			template <types::size I, typename... Ts>
+			using field =
+				typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+			/**
+			 * Get the alignment of the columns of the given array.
+			 *
+			 * @param arr Array object to query
+			 * @return The alignment, never less than the one of any field
+			 */
+			template <typename... Ts>
+			inline types::size get_align(const soa<Ts...>& arr) {
+				const types::size aligns[] = { alignof(Ts)... };
+
+				types::size al = arr.align ? arr.align : simd_align;
+				for (auto a : aligns) {
+					al = a > al ? a : al;
+				}
+
+				return al;
+			}
+
+			/**
+			 * Compute where columns start, from the beginning of the block.
+			 *
+			 * @param capacity Elements per column
+			 * @param align Alignment of the columns
+			 * @param offsets Offset of every column, in bytes
+			 * @return Size in bytes of the block
+			 */
+			template <typename... Ts>
+			inline types::size compute_layout(types::size capacity,
+				types::size align, types::size* offsets) {
+				const types::size sizes[] = { sizeof(Ts)... };
+
+				types::size end = 0;
+				for (types::size i = 0; i < sizeof...(Ts); ++i) {
+					end = (end + align - 1) & ~(align - 1);
+					offsets[i] = end;
+					end += sizes[i] * capacity;
+				}
+
+				return end;
+			}
+
+			/**
+			 * Get the column of the `I`-th field.
+			 *
+			 * @tparam I Field index
+			 * @param arr Array object to query
+			 * @return First element of the column, aligned
+			 */
+			template <types::size I, typename... Ts>
+			inline field<I, Ts...>* get_column(soa<Ts...>& arr) {
+				return static_cast<field<I, Ts...>*>(arr.columns[I]);
+			}
+
+			/**
+			 * Get the column of the `I`-th field.
+			 *
+			 * @tparam I Field index
+			 * @param arr Array object to query
+			 * @return First element of the column, aligned
+			 */
+			template <types::size I, typename... Ts>
+			inline const field<I, Ts...>* get_column(const soa<Ts...>& arr) {
+				return static_cast<const field<I, Ts...>*>(arr.columns[I]);
+			}
+
+			/**
+			 * Get the number of elements in the array.
+			 */
+			template <typename... Ts>
+			inline types::size get_count(const soa<Ts...>& arr) {
+				return arr.count;
+			}
+
+			/**
+			 * Get the number of elements the columns have room for.
+			 */
+			template <typename... Ts>
+			inline types::size get_capacity(const soa<Ts...>& arr) {
+				return arr.capacity;
+			}
+
+			/**
+			 * Whether the array has no elements.
+			 */
+			template <typename... Ts>
+			inline types::boolean is_empty(const soa<Ts...>& arr) {
+				return arr.count == 0;
+			}
+
+			/**
+			 * Move the columns to a block of the given capacity.
+			 *
+			 * Column offsets depend on the capacity, so the block can't be
+			 * reallocated in place, elements are copied column by column.
+			 *
+			 * @param dst Array to operate on
+			 * @param new_capacity Elements per column, not less than `count`
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts>
+			inline types::boolean reallocate(soa<Ts...>& dst,
+				types::size new_capacity) {
+				angie_assert(dst.ator && new_capacity >= dst.count);
+
+				const types::size sizes[] = { sizeof(Ts)... };
+				const auto al = get_align(dst);
+
+				types::size offsets[sizeof...(Ts)];
+				types::byte* block = nullptr;
+
+				if (new_capacity) {
+					block = static_cast<types::byte*>(runtime_allocator::alloc(
+						dst.ator, compute_layout<Ts...>(new_capacity, al,
+							offsets), al));
+
+					// Allocation might fail
+					if (!block) {
+						return false;
+					}
+				}
+
+				// The first column starts the block, whose layout depends on
+				// the alignment at the time, `align` might have changed since.
+				types::size old_offsets[sizeof...(Ts)];
+				void* old_block = dst.columns[0];
+				const auto old_bytes = compute_layout<Ts...>(
+					dst.capacity, dst.block_align, old_offsets);
+
+				for (types::size i = 0; i < sizeof...(Ts); ++i) {
+					void* column = block ? block + offsets[i] : nullptr;
+					if (dst.count) {
+						memory::copy(column, dst.columns[i],
+							sizes[i] * dst.count);
+					}
+
+					dst.columns[i] = column;
+				}
+
+				if (old_block) {
+					runtime_allocator::dealloc(dst.ator, old_block, old_bytes);
+				}
+
+				dst.capacity = new_capacity;
+				dst.block_align = static_cast<types::uint16>(al);
+				return true;
+			}
+
+			/**
+			 * Reserve space for `num` more elements in every column.
+			 *
+			 * @param dst Array to grow
+			 * @param num Least number of elements to reserve memory for
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts>
+			inline types::boolean reserve(soa<Ts...>& dst, types::size num) {
+				if (!dst.ator) {
+					return false;
+				}
+
+				const auto new_capacity = compute_capacity(dst.grow,
+					dst.capacity, dst.count + num, dst.chunk);
+
+				return new_capacity == dst.capacity
+					|| reallocate(dst, new_capacity);
+			}
+
+			/**
+			 * Initialise the given array.
+			 *
+			 * Growth policy and alignment are taken from the array, set them
+			 * before this call, if the defaults are not suitable.
+			 *
+			 * @param dst Zero initialised array
+			 * @param num Initial capacity, ceil-ed according to the policy
+			 * @param alloc_to_use Allocator of the array memory
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts>
+			inline types::boolean init(soa<Ts...>& dst, types::size num = 0,
+				const memory::allocator* alloc_to_use =
+					runtime_allocator::get_allocator()) {
+				angie_assert(is_empty(dst));
+				angie_assert(!dst.align || utils::is_power_of_two(dst.align));
+				if (dst.ator == nullptr) {
+					dst.ator = alloc_to_use;
+				}
+
+				return reserve(dst, num);
+			}
+
+			/**
+			 * Release memory, and empty the array.
+			 *
+			 * The allocator is kept, the array can be used again.
+			 */
+			template <typename... Ts>
+			inline void release(soa<Ts...>& arr) {
+				arr.count = 0;
+				if (arr.capacity) {
+					reallocate(arr, 0);
+				}
+			}
+
+			/**
+			 * Instantiate a new array object.
+			 *
+			 * @param reserve Initial number of elements to reserve memory for
+			 * @param alloc_to_use Allocator of the array, and its memory
+			 * @param policy Growth policy of the array
+			 * @param chunk Elements per chunk, for `growth::chunked`
+			 * @param align Alignment of the columns, zero for `simd_align`
+			 * @return Not null object on success, nullptr otherwise
+			 */
+			template <typename... Ts>
+			inline soa<Ts...>* make_soa(types::size reserve = 0,
+				const memory::allocator* alloc_to_use =
+					runtime_allocator::get_allocator(),
+				growth policy = growth::power_of_two,
+				types::uint32 chunk = 0, types::uint16 align = 0) {
+				auto* buffer = runtime_allocator::alloc(alloc_to_use,
+					sizeof(soa<Ts...>), alignof(soa<Ts...>));
+
+				// Memory allocation can fail
+				if (!buffer) {
+					return nullptr;
+				}
+
+				auto* arr = new(buffer) soa<Ts...> {};
+				arr->grow = policy;
+				arr->chunk = chunk;
+				arr->align = align;
+
+				if (!init(*arr, reserve, alloc_to_use)) {
+					runtime_allocator::dealloc(alloc_to_use, buffer,
+						sizeof(*arr));
+					return nullptr;
+				}
+
+				return arr;
+			}
+
+			/**
+			 * Release and destroy the given array.
+			 *
+			 * @param arr Array made by `make_soa()`, it will be set to null
+			 */
+			template <typename... Ts>
+			inline void destroy(soa<Ts...>*& arr) {
+				if (arr) {
+					auto* allocator = arr->ator;
+					release(*arr);
+					runtime_allocator::dealloc(allocator, arr, sizeof(*arr));
+					arr = nullptr;
+				}
+			}
+
+			/**
+			 * Remove all the elements, keeping the memory.
+			 */
+			template <typename... Ts>
+			inline void clear(soa<Ts...>& dst) {
+				dst.count = 0;
+			}
+
+			/**
+			 * Reallocate memory to best fit the number of elements.
+			 *
+			 * @param dst Array to operate on
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts>
+			inline types::boolean fit(soa<Ts...>& dst) {
+				const auto new_capacity = compute_capacity(dst.grow, 0,
+					dst.count, dst.chunk);
+
+				return new_capacity >= dst.capacity || !dst.ator
+					|| reallocate(dst, new_capacity);
+			}
+
+			/**
+			 * Change the number of elements in the array.
+			 *
+			 * Fields of new elements are left uninitialised.
+			 *
+			 * @param dst Array to resize
+			 * @param new_count Number of elements
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts>
+			inline types::boolean resize(soa<Ts...>& dst,
+				types::size new_count) {
+				if (new_count > dst.capacity
+					&& !reserve(dst, new_count - dst.count)) {
+					return false;
+				}
+
+				dst.count = new_count;
+				return true;
+			}
+
+			/**
+			 * Add one element at the end of the array.
+			 *
+			 * Field types are taken from the array only, values are
+			 * converted to them, as if they were cast.
+			 *
+			 * @param dst Array to add the element to
+			 * @param fields Value of every field of the element
+			 * @return true if successful, false otherwise
+			 */
+			template <typename... Ts, typename... Us>
+			inline types::boolean push(soa<Ts...>& dst, Us&&... fields) {
+				static_assert(sizeof...(Us) == sizeof...(Ts),
+					"A value is needed for every field");
+
+				if (angie_likely(dst.count < dst.capacity)
+					|| reserve(dst, 1)) {
+					types::size i = 0;
+					const int expand[] = { 0, (static_cast<Ts*>(
+						dst.columns[i++])[dst.count] = static_cast<Ts>(
+							std::forward<Us>(fields)), 0)... };
+					(void)expand;
+
+					++dst.count;
+					return true;
+				}
+
+				return false;
+			}
+
+			/**
+			 * Remove `num` elements, filling the gap with the last ones.
+			 *
+			 * @param dst Array to operate on
+			 * @param from Position where starting to replace from
+			 * @param num Number of elements to remove
+			 * @return true if successful, false otherwise
+			 * @see replace_with_last(dynamic<T, A>&, types::uintptr, types::size)
+			 */
+			template <typename... Ts>
+			inline types::boolean replace_with_last(soa<Ts...>& dst,
+				types::uintptr from, types::size num = 1) {
+				angie_assert(from < dst.count);
+
+				const types::size sizes[] = { sizeof(Ts)... };
+				auto n_to_remove = algorithm::min(num, dst.count - from);
+				auto move_from = algorithm::max(
+					dst.count - n_to_remove, from + n_to_remove);
+
+				if (auto n_to_move = dst.count - move_from) {
+					for (types::size i = 0; i < sizeof...(Ts); ++i) {
+						auto* column = static_cast<types::byte*>(
+							dst.columns[i]);
+						memory::move(column + from * sizes[i],
+							column + move_from * sizes[i],
+							n_to_move * sizes[i]);
+					}
+				}
+
+				dst.count -= n_to_remove;
+				return true;
+			}
+
+		}
+	}
+}
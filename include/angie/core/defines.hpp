@@ -303,6 +303,21 @@
 #endif
 #endif
 
+/**
+ * Branch prediction hints
+ *
+ * @def angie_likely(c)
+ * @def angie_unlikely(c)
+ * @param c Condition expected to be, respectively, true or false
+ */
+#if defined(ANGIE_CC_CLANG) || defined(ANGIE_CC_GNU)
+#define angie_likely(c) __builtin_expect(!!(c), 1)
+#define angie_unlikely(c) __builtin_expect(!!(c), 0)
+#else
+#define angie_likely(c) (!!(c))
+#define angie_unlikely(c) (!!(c))
+#endif
+
 /**
  * Whether or not the given pointer "p" is aligned to, or multiple of, "c"
  *
@@ -14,16 +14,35 @@ namespace angie {
 
             /**
              * Simple structure that holds a v-table of allocation functions.
+             *
+             * Every function receives the `context` of the allocator as its
+             * first parameter, this way allocators holding a state (arenas,
+             * pools, etc.) can share the same v-table layout of the stateless
+             * ones. Stateless allocators can simply leave `context` null.
+             *
+             * Optional entries follow the `context`, and can be left null by
+             * allocators not supporting them. `try_expand` grows a block in
+             * place, without ever moving it, and returns whether it could.
+             * `free_sized` releases a block whose size is known by the caller,
+             * sparing the allocator to look it up.
              */
             struct allocator {
-                using vtb_alloc = void* (types::size sz, types::size al);
-                using vtb_free = void (void* ptr);
-                using vtb_realloc = void* (void* ptr, types::size sz,
-                                           types::size al);
+                using vtb_alloc = void* (void* ctx, types::size sz,
+                                         types::size al);
+                using vtb_free = void (void* ctx, void* ptr);
+                using vtb_realloc = void* (void* ctx, void* ptr,
+                                           types::size sz, types::size al);
+                using vtb_try_expand = types::boolean (void* ctx, void* ptr,
+                                                       types::size sz);
+                using vtb_free_sized = void (void* ctx, void* ptr,
+                                             types::size sz);
 
                 vtb_alloc* const alloc;
                 vtb_free* const free;
                 vtb_realloc* const realloc;
+                void* const context;
+                vtb_try_expand* const try_expand;
+                vtb_free_sized* const free_sized;
             };
 
             /**
@@ -35,6 +54,81 @@ namespace angie {
              */
             const allocator* get_default_allocator();
 
+            /**
+             * Allocate memory through the given allocator.
+             *
+             * @param ator Allocator to use, must be not-null
+             * @param sz Number of bytes to allocate
+             * @param al Alignment of the returned pointer
+             * @return Pointer to the allocated memory, nullptr on failure
+             */
+            inline void* alloc(const allocator* ator, types::size sz,
+                               types::size al) {
+                return ator->alloc(ator->context, sz, al);
+            }
+
+            /**
+             * Free memory previously allocated through the given allocator.
+             *
+             * @param ator Allocator the pointer has been allocated with
+             * @param ptr Pointer to release
+             */
+            inline void dealloc(const allocator* ator, void* ptr) {
+                ator->free(ator->context, ptr);
+            }
+
+            /**
+             * Free memory whose size is known, through the given allocator.
+             *
+             * Allocators without a sized entry fall back to `free`.
+             *
+             * @param ator Allocator the pointer has been allocated with
+             * @param ptr Pointer to release
+             * @param sz Size requested when the pointer has been allocated,
+             *        or any size up to the one the block can hold
+             */
+            inline void dealloc(const allocator* ator, void* ptr,
+                                types::size sz) {
+                if (ator->free_sized) {
+                    ator->free_sized(ator->context, ptr, sz);
+                } else {
+                    ator->free(ator->context, ptr);
+                }
+            }
+
+            /**
+             * Reallocate memory through the given allocator.
+             *
+             * @param ator Allocator the pointer has been allocated with
+             * @param ptr Pointer to reallocate, it can be null
+             * @param sz New size in bytes
+             * @param al Alignment of the returned pointer
+             * @return Pointer to the reallocated memory, nullptr on failure
+             */
+            inline void* realloc(const allocator* ator, void* ptr,
+                                 types::size sz, types::size al) {
+                return ator->realloc(ator->context, ptr, sz, al);
+            }
+
+            /**
+             * Grow a block in place, through the given allocator.
+             *
+             * Unlike `realloc()`, this never moves the block, so it never
+             * copies its content. It fails when the memory following the
+             * block is not available, or the allocator can't tell.
+             *
+             * @param ator Allocator the pointer has been allocated with
+             * @param ptr Pointer to expand, it can be null
+             * @param sz Least number of bytes the block must hold
+             * @return true if the block can hold `sz` bytes now,
+             *         false otherwise, and the block is left untouched
+             */
+            inline types::boolean try_expand(const allocator* ator, void* ptr,
+                                             types::size sz) {
+                return ptr && ator->try_expand
+                    && ator->try_expand(ator->context, ptr, sz);
+            }
+
         }
     }
 }
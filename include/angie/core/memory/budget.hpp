@@ -0,0 +1,158 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace budget {
+
+                struct account;
+
+                /**
+                 * Function called when an account crosses its soft limit.
+                 *
+                 * It runs on the thread whose request crossed the limit,
+                 * before the request returns, and it may free memory of
+                 * the account, i.e. evicting caches, or call flush().
+                 *
+                 * @param a Account under pressure
+                 * @param used Bytes in use, past the soft limit
+                 * @param user_data Pointer given at creation time
+                 */
+                using pressure_callback = void (account& a, types::size used,
+                                                void* user_data);
+
+                /**
+                 * Allocator wrapper enforcing a memory budget.
+                 *
+                 * Every subsystem gets its own account, named after it, and
+                 * all of its memory requests go through the account allocator.
+                 * Bytes requested are charged to the account before being
+                 * forwarded to the parent. A request that would push the usage
+                 * past the hard limit fails straight away, without reaching the
+                 * parent, while crossing the soft limit fires the pressure
+                 * callback, once, until the usage goes below the limit again.
+                 *
+                 * @param ator V-table handed out to the subsystem
+                 * @param name Name of the account, it must outlive it
+                 * @param soft Bytes past which the callback fires, 0 if none
+                 * @param hard Bytes never exceeded, 0 for no limit
+                 * @param on_pressure Called on soft limit crossing, can be null
+                 * @param user_data Passed through to `on_pressure`
+                 * @param used Bytes currently charged to the account
+                 * @param peak Highest value `used` has ever reached
+                 * @param failures Number of requests denied by the hard limit
+                 * @param next Next account of the registry
+                 * @param parent Allocator requests are forwarded to
+                 * @note Thread-safe, as long as the parent allocator is.
+                 */
+                struct account {
+                    const allocator             ator;
+                    const types::char8* const   name;
+                    const types::size           soft;
+                    const types::size           hard;
+                    pressure_callback* const    on_pressure;
+                    void* const                 user_data;
+                    std::atomic<types::size>    used;
+                    std::atomic<types::size>    peak;
+                    std::atomic<types::size>    failures;
+                    account*                    next;
+                    const allocator*            parent;
+                };
+
+                /**
+                 * Instantiate a new account, and register it.
+                 *
+                 * @param name Name of the account, i.e. "textures"
+                 * @param soft Bytes past which `on_pressure` fires, 0 if none
+                 * @param hard Bytes never exceeded, 0 for no limit
+                 * @param on_pressure Called on soft limit crossing, can be null
+                 * @param user_data Passed through to `on_pressure`
+                 * @param parent Allocator requests are forwarded to
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                account* make(const types::char8* name, types::size soft,
+                              types::size hard,
+                              pressure_callback* on_pressure = nullptr,
+                              void* user_data = nullptr,
+                              const allocator* parent =
+                              get_default_allocator());
+
+                /**
+                 * Unregister and release the account.
+                 *
+                 * Blocks still allocated must be freed before this call.
+                 *
+                 * @param a Account to destroy, it will be set to null
+                 */
+                void destroy(account*& a);
+
+                /**
+                 * Get the allocator v-table of the given account.
+                 *
+                 * @param a Account to allocate from
+                 * @return Allocator charging the given account
+                 */
+                inline const allocator* get_allocator(const account& a) {
+                    return &a.ator;
+                }
+
+                /**
+                 * Bytes currently charged to the account.
+                 */
+                inline types::size get_used(const account& a) {
+                    return a.used.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * Highest number of bytes ever charged to the account.
+                 */
+                inline types::size get_peak(const account& a) {
+                    return a.peak.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * Number of requests denied by the hard limit.
+                 */
+                inline types::size get_failures(const account& a) {
+                    return a.failures.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * Find a registered account by name.
+                 *
+                 * @param name Name given at creation time
+                 * @return The account if found, nullptr otherwise
+                 */
+                account* find(const types::char8* name);
+
+                /**
+                 * Function receiving every registered account.
+                 */
+                using visitor = void (const account& a, void* user_data);
+
+                /**
+                 * Visit all the registered accounts.
+                 *
+                 * Accounts can't be made, or destroyed, from the visitor.
+                 *
+                 * @param visit Function called once per account
+                 * @param user_data Passed through to `visit`
+                 */
+                void for_each(visitor* visit, void* user_data = nullptr);
+
+            }
+        }
+    }
+}
@@ -37,6 +37,47 @@ namespace angie {
              */
             void deallocate(void* pointer);
 
+            /**
+             * Deallocate a global pointer whose size is known.
+             *
+             * Memory managers can skip looking the size of the
+             * block up, which is what deallocate() has to do.
+             * @param pointer This pointer has to be allocated by allocate().
+             * @param size Size passed to allocate(), or any size not bigger
+             * than the one returned by size_of().
+             * @note Thread-safe.
+             */
+            void deallocate(void* pointer, types::size size);
+
+            /**
+             * Allocate several blocks of the same size in one call.
+             *
+             * Either all the blocks are allocated, or none is.
+             * @param pointers Array receiving `count` pointers.
+             * @param count Number of blocks to allocate.
+             * @param size Number of adjacent bytes of every block.
+             * @param alignment Every pointer will be aligned by this value.
+             * @return true on success, false otherwise, in which case
+             * the content of `pointers` is undefined.
+             * @note Thread-safe.
+             */
+            types::boolean allocate_n(void** pointers, types::size count,
+                                      types::size size,
+                                      types::size alignment =
+                                      ANGIE_DEFAULT_MEMORY_ALIGNMENT);
+
+            /**
+             * Deallocate several blocks of the same size in one call.
+             *
+             * @param pointers Pointers allocated by allocate() or
+             * allocate_n(), null pointers are skipped.
+             * @param count Number of pointers to deallocate.
+             * @param size Size of every block, as for sized deallocate().
+             * @note Thread-safe.
+             */
+            void deallocate_n(void** pointers, types::size count,
+                              types::size size);
+
             /**
              * Reallocate memory from the pointer provided.
              *
@@ -57,6 +98,21 @@ namespace angie {
              */
             void* reallocate(void* ptr, types::size sz, types::size al = 0);
 
+            /**
+             * Grow the given pointer in place.
+             *
+             * The memory is never moved, therefore, no copy takes place.
+             * Whether the block can grow depends on the memory manager,
+             * and on the memory following the block.
+             *
+             * @param ptr Memory pointer previously allocated
+             * @param sz Least number of bytes the block must hold
+             * @return true if `ptr` can hold `sz` bytes now, false
+             * otherwise, in which case `ptr` is left untouched.
+             * @note Thread-safe.
+             */
+            types::boolean try_expand(void* ptr, types::size sz);
+
             /**
              * Flush global memory.
              *
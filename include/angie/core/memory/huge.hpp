@@ -0,0 +1,104 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace huge {
+
+                /**
+                 * Huge page backed allocator, for large buffers.
+                 *
+                 * Blocks of at least `threshold` bytes are mapped directly
+                 * from the system, trying, in order:
+                 *  - explicit huge pages (MAP_HUGETLB, MEM_LARGE_PAGES);
+                 *  - transparent huge pages (madvise(MADV_HUGEPAGE));
+                 *  - regular pages.
+                 * Smaller blocks are forwarded to the parent allocator.
+                 * Use `page_size_of()` to know which page size a block
+                 * actually got.
+                 *
+                 * @param ator V-table handed out to the clients
+                 * @param threshold Least size of a block mapped by pages
+                 * @param parent Allocator small blocks are served from
+                 * @note Thread-safe, as long as the parent allocator is.
+                 */
+                struct heap {
+                    const allocator     ator;
+                    types::size         threshold;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * Instantiate a new huge page allocator.
+                 *
+                 * @param threshold Least size of blocks to map by pages
+                 * @param parent Allocator used for the allocator itself and
+                 *      for blocks smaller than `threshold`
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                heap* make(types::size threshold = ANGIE_MEMORY_HUGE_THRESHOLD,
+                           const allocator* parent = get_default_allocator());
+
+                /**
+                 * Release the allocator.
+                 *
+                 * Blocks still allocated are not released, and must be
+                 * freed before calling this function.
+                 *
+                 * @param h Allocator to destroy, it will be set to null
+                 */
+                void destroy(heap*& h);
+
+                /**
+                 * Get the allocator v-table of the given heap.
+                 *
+                 * @param h Heap to allocate from
+                 * @return Allocator operating on the given heap
+                 */
+                inline const allocator* get_allocator(const heap& h) {
+                    return &h.ator;
+                }
+
+                /**
+                 * Huge page size supported by the system.
+                 *
+                 * @return Page size in bytes, 0 if huge pages are not
+                 *      supported at all
+                 */
+                types::size get_huge_page_size();
+
+                /**
+                 * Page size backing the given block.
+                 *
+                 * For transparent huge pages, the system may still back
+                 * parts of the block with regular pages, when it can't
+                 * find contiguous physical memory.
+                 *
+                 * @param ptr Block allocated from a huge page allocator
+                 * @return Page size in bytes, 0 if the block is served
+                 *      by the parent allocator
+                 */
+                types::size page_size_of(const void* ptr);
+
+                /**
+                 * Whether the block relies on transparent huge pages.
+                 *
+                 * @param ptr Block allocated from a huge page allocator
+                 * @return true if huge pages have only been advised
+                 */
+                types::boolean is_transparent(const void* ptr);
+
+            }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace linear {
+
+                /**
+                 * Bump-pointer arena.
+                 *
+                 * Memory is requested once to the parent allocator, then,
+                 * every allocation simply moves the `top` pointer forward.
+                 * Single blocks are not freed, but the last one allocated,
+                 * while the whole arena can be rewound in O(1) with `reset()`.
+                 * This makes it ideal for per-frame scratch memory.
+                 *
+                 * @param ator V-table handed out to the clients of the arena
+                 * @param begin First usable byte of the arena
+                 * @param top Next free byte of the arena
+                 * @param end One byte past the last usable one
+                 * @param last Last allocated block, it can be grown in place
+                 * @param parent Allocator the arena memory comes from
+                 * @note Not thread-safe.
+                 */
+                struct arena {
+                    const allocator     ator;
+                    types::byte*        begin;
+                    types::byte*        top;
+                    types::byte*        end;
+                    types::byte*        last;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * Instantiate a new arena.
+                 *
+                 * The arena structure and its buffer are allocated in one
+                 * go from the `parent` allocator.
+                 *
+                 * @param capacity Number of bytes the arena can serve
+                 * @param parent Allocator used to request the arena memory
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                arena* make(types::size capacity,
+                            const allocator* parent = get_default_allocator());
+
+                /**
+                 * Return the arena memory to its parent allocator.
+                 *
+                 * Any pointer allocated from this arena is invalid after
+                 * this call, and so is any array using it as allocator.
+                 *
+                 * @param a Arena to destroy, it will be set to null
+                 */
+                void destroy(arena*& a);
+
+                /**
+                 * Release all the allocations at once.
+                 *
+                 * @param a Arena to rewind
+                 */
+                void reset(arena& a);
+
+                /**
+                 * Get the allocator v-table of the given arena.
+                 *
+                 * Freeing a pointer through this allocator is a no-op,
+                 * unless it is the last allocated block.
+                 *
+                 * @param a Arena to allocate from
+                 * @return Allocator operating on the given arena
+                 */
+                inline const allocator* get_allocator(const arena& a) {
+                    return &a.ator;
+                }
+
+                /**
+                 * Number of bytes currently in use, including padding.
+                 *
+                 * @param a Arena to query
+                 * @return Bytes allocated since last `reset()`
+                 */
+                inline types::size get_used(const arena& a) {
+                    return static_cast<types::size>(a.top - a.begin);
+                }
+
+                /**
+                 * Total number of bytes the arena can serve.
+                 *
+                 * @param a Arena to query
+                 * @return Capacity of the arena in bytes
+                 */
+                inline types::size get_capacity(const arena& a) {
+                    return static_cast<types::size>(a.end - a.begin);
+                }
+
+            }
+        }
+    }
+}
@@ -63,6 +63,30 @@ namespace angie {
             types::boolean is_equal(const void* dst, const void* src,
 				                    types::size bytes);
 
+            /**
+             * Back the functions above with the fastest kernels the CPU runs.
+             *
+             * Until this is called, the C library functions are used. Copies
+             * and sets bigger than the last level cache bypass the caches,
+             * in order not to evict the working set of the application.
+             *
+             * @return Name of the kernels chosen, i.e. "avx2"
+             * @note Called by system::init(), not thread-safe.
+             */
+            const types::char8* select_kernels();
+
+            /**
+             * Set the size beyond which copies and sets bypass the caches.
+             *
+             * select_kernels() sets it to the size of the last level cache,
+             * override it afterwards, if it doesn't suit the application.
+             *
+             * @param bytes New threshold, in bytes
+             * @return The previous threshold
+             * @note Not thread-safe.
+             */
+            types::size set_stream_threshold(types::size bytes);
+
         }
     }
 }
\ No newline at end of file
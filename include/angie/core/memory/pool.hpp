@@ -0,0 +1,125 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace pool {
+
+                /**
+                 * Smallest block size served by the pool.
+                 */
+                constexpr types::size min_block_size = 8;
+
+                /**
+                 * Biggest block size served from the slabs.
+                 *
+                 * Bigger requests are forwarded to the parent allocator.
+                 */
+                constexpr types::size max_block_size = 256;
+
+                /**
+                 * Number of size classes, one per power of two
+                 * between `min_block_size` and `max_block_size`.
+                 */
+                constexpr types::size class_count = 6;
+
+                /**
+                 * Per size class state.
+                 *
+                 * @param free_list Intrusive list of freed blocks
+                 * @param cursor Next never used block of the current slab
+                 * @param cursor_end End of the current slab
+                 */
+                struct bin {
+                    void*               free_list;
+                    types::byte*        cursor;
+                    types::byte*        cursor_end;
+                };
+
+                /**
+                 * Size-class pool allocator.
+                 *
+                 * Blocks of the same size class are packed together into
+                 * slabs of ANGIE_MEMORY_POOL_SLAB_SIZE bytes, aligned to
+                 * their own size. Because of that, the slab a block belongs
+                 * to is found masking the block address, and no per-block
+                 * header is needed. Freed blocks are kept in an intrusive
+                 * list per class, making allocation and release O(1).
+                 * Size classes are powers of two, so that every block is
+                 * naturally aligned to its own size.
+                 *
+                 * @param ator V-table handed out to the clients of the pool
+                 * @param bins Size classes state
+                 * @param chunks List of chunks requested to the parent
+                 * @param slab Next unused slab of the current chunk
+                 * @param slab_end End of the current chunk
+                 * @param large List of blocks bigger than `max_block_size`
+                 * @param parent Allocator the pool memory comes from
+                 * @note Not thread-safe.
+                 */
+                struct heap {
+                    const allocator     ator;
+                    bin                 bins[class_count];
+                    void*               chunks;
+                    types::byte*        slab;
+                    types::byte*        slab_end;
+                    void*               large;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * Instantiate a new pool.
+                 *
+                 * No slab is requested until the first allocation.
+                 *
+                 * @param parent Allocator used to request slabs
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                heap* make(const allocator* parent = get_default_allocator());
+
+                /**
+                 * Return all the pool memory to its parent allocator.
+                 *
+                 * Any pointer allocated from this pool is invalid after
+                 * this call, and so is any array using it as allocator.
+                 *
+                 * @param h Pool to destroy, it will be set to null
+                 */
+                void destroy(heap*& h);
+
+                /**
+                 * Get the allocator v-table of the given pool.
+                 *
+                 * Alignments can't be greater than or equal to the
+                 * slab size, in such case allocations will fail.
+                 *
+                 * @param h Pool to allocate from
+                 * @return Allocator operating on the given pool
+                 */
+                inline const allocator* get_allocator(const heap& h) {
+                    return &h.ator;
+                }
+
+                /**
+                 * Retrieve the usable size of a block.
+                 *
+                 * @param h Pool the block has been allocated from
+                 * @param ptr Block to query
+                 * @return Usable size of the block, zero if null
+                 */
+                types::size size_of(const heap& h, void* ptr);
+
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace profiler {
+
+                /**
+                 * Sampled heap profiler.
+                 *
+                 * When ANGIE_MEMORY_PROFILER is defined, roughly one block
+                 * every `rate` bytes allocated by `memory::allocate()` is
+                 * sampled, and its callstack captured. Sampled blocks still
+                 * alive are aggregated by call site, each one weighting the
+                 * number of bytes it statistically represents. Without the
+                 * define, these functions do nothing.
+                 */
+
+                /**
+                 * Set the average number of bytes between two samples.
+                 *
+                 * @param bytes Sampling interval, 0 disables sampling
+                 */
+                void set_sample_rate(types::size bytes);
+
+                /**
+                 * Get the average number of bytes between two samples.
+                 *
+                 * @return Sampling interval, 0 if sampling is disabled
+                 */
+                types::size get_sample_rate();
+
+                /**
+                 * Receives the report, one line at the time.
+                 *
+                 * @param line Null terminated line, without new line
+                 * @param user_data Pointer passed to `dump()`
+                 */
+                using line_callback = void (const types::char8* line,
+                                            void* user_data);
+
+                /**
+                 * Report the live heap by call site.
+                 *
+                 * Lines are in the collapsed stack format, consumed by
+                 * flamegraph.pl, speedscope and pprof converters, that is,
+                 * frames from the outermost call separated by semicolons,
+                 * followed by a space and the estimated live bytes:
+                 * `main;load_level;make_mesh 1048576`
+                 *
+                 * @param cb Function receiving the report lines
+                 * @param user_data Pointer passed back to the callback
+                 * @return Number of lines emitted
+                 */
+                types::size dump(line_callback* cb, void* user_data = nullptr);
+
+            }
+        }
+    }
+}
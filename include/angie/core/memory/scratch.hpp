@@ -0,0 +1,72 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+#include "angie/core/memory/stack.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace scratch {
+
+                /**
+                 * Rewind the scratch memory of the thread on exit.
+                 *
+                 * Every thread owns a stack region, of
+                 * ANGIE_MEMORY_SCRATCH_SIZE bytes, requested to the
+                 * default allocator the first time a scope is opened on
+                 * it, and given back when the thread exits. A scope takes
+                 * a marker of the region, and rewinds to it when it goes
+                 * out of scope, releasing all the blocks allocated within
+                 * it at once. Scopes can be nested, but they must not be
+                 * passed to other threads, and nothing allocated from a
+                 * scope can outlive it.
+                 *
+                 * Allocations fail when the region is exhausted, while,
+                 * if the region itself can't be allocated, the scope
+                 * falls back to the default allocator.
+                 *
+                 * @code
+                 * memory::scratch::scope tmp;
+                 * array::dynamic<uint32> ids = { 0 };
+                 * array::init(ids, 64, tmp.get_allocator());
+                 * @endcode
+                 */
+                struct scope {
+                    scope();
+                    ~scope();
+
+                    scope(const scope&) = delete;
+                    scope& operator=(const scope&) = delete;
+
+                    /**
+                     * Allocator serving the scratch memory of this scope.
+                     *
+                     * @return Not null allocator, valid until the scope ends
+                     */
+                    const allocator* get_allocator() const;
+
+                private:
+                    stack::region*      region;
+                    stack::marker       mark;
+                };
+
+                /**
+                 * Number of bytes left in the scratch memory of the thread.
+                 *
+                 * @return Free bytes of the region, 0 if no
+                 *      scope has ever been opened on this thread
+                 */
+                types::size get_free();
+
+            }
+        }
+    }
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace stack {
+
+                /**
+                 * End of the region to allocate from.
+                 */
+                enum class side {
+                    low,    /*!< Grows upward from the beginning */
+                    high    /*!< Grows downward from the end */
+                };
+
+                /**
+                 * Double-ended LIFO allocator.
+                 *
+                 * One block of memory is shared by two stacks, growing
+                 * towards each other, the region is full when they meet.
+                 * Using only the low side makes it a plain stack allocator.
+                 * On both sides, freeing the last allocated block rolls the
+                 * top back to the previous one, while freeing blocks out of
+                 * order does nothing, their memory is reclaimed by rewinding
+                 * to a marker taken before them.
+                 *
+                 * @param low V-table allocating from the low side
+                 * @param high V-table allocating from the high side
+                 * @param begin First usable byte of the region
+                 * @param low_top Next free byte of the low side
+                 * @param low_last Last block allocated from the low side
+                 * @param high_top One byte past the free space of the high side
+                 * @param high_last Last block allocated from the high side
+                 * @param end One byte past the last usable one
+                 * @param parent Allocator the region memory comes from
+                 * @note Not thread-safe.
+                 */
+                struct region {
+                    const allocator     low;
+                    const allocator     high;
+                    types::byte*        begin;
+                    types::byte*        low_top;
+                    types::byte*        low_last;
+                    types::byte*        high_top;
+                    types::byte*        high_last;
+                    types::byte*        end;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * State of one side of the region, at a given time.
+                 */
+                struct marker {
+                    types::byte*        top;
+                    types::byte*        last;
+                };
+
+                /**
+                 * Instantiate a new region.
+                 *
+                 * The region structure and its buffer are allocated in one
+                 * go from the `parent` allocator.
+                 *
+                 * @param capacity Number of bytes shared by the two sides
+                 * @param parent Allocator used to request the region memory
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                region* make(types::size capacity,
+                             const allocator* parent = get_default_allocator());
+
+                /**
+                 * Return the region memory to its parent allocator.
+                 *
+                 * @param r Region to destroy, it will be set to null
+                 */
+                void destroy(region*& r);
+
+                /**
+                 * Get the allocator v-table of one side of the region.
+                 *
+                 * @param r Region to allocate from
+                 * @param from Side the allocator takes memory from
+                 * @return Allocator operating on the given side
+                 */
+                inline const allocator* get_allocator(const region& r,
+                                                      side from = side::low) {
+                    return from == side::low ? &r.low : &r.high;
+                }
+
+                /**
+                 * Take a marker of the current state of one side.
+                 *
+                 * @param r Region to take the marker of
+                 * @param from Side to take the marker of
+                 * @return Marker to pass to `free_to_marker()`
+                 */
+                inline marker get_marker(const region& r,
+                                         side from = side::low) {
+                    return from == side::low
+                        ? marker { r.low_top, r.low_last }
+                        : marker { r.high_top, r.high_last };
+                }
+
+                /**
+                 * Release all the blocks allocated after the marker.
+                 *
+                 * Markers taken after this one become invalid.
+                 *
+                 * @param r Region to rewind
+                 * @param m Marker taken from the same side of this region
+                 * @param from Side to rewind
+                 */
+                void free_to_marker(region& r, const marker& m,
+                                    side from = side::low);
+
+                /**
+                 * Release all the blocks of both sides.
+                 *
+                 * @param r Region to rewind
+                 */
+                void reset(region& r);
+
+                /**
+                 * Number of bytes still available to both sides.
+                 *
+                 * @param r Region to query
+                 * @return Bytes between the two tops, including the
+                 *      space needed for block headers and padding
+                 */
+                inline types::size get_free(const region& r) {
+                    return static_cast<types::size>(r.high_top - r.low_top);
+                }
+
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+#include "angie/core/system/system.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace stats {
+
+                /**
+                 * Number of buckets of the allocation size histogram.
+                 *
+                 * Bucket `i` counts requests up to `16 << i` bytes, but
+                 * the last one, which counts all the bigger requests.
+                 */
+                constexpr types::size histogram_bins = 16;
+
+                /**
+                 * Lock-free counters, updated on every operation.
+                 *
+                 * @param live Bytes currently allocated
+                 * @param peak Highest value `live` has ever reached
+                 * @param allocations Number of blocks allocated
+                 * @param deallocations Number of blocks freed
+                 * @param reallocations Number of blocks reallocated
+                 * @param copied Bytes moved by reallocations, because
+                 *      the block couldn't be resized in place
+                 * @param histogram Allocations count per size bucket
+                 */
+                struct counters {
+                    std::atomic<types::size>    live;
+                    std::atomic<types::size>    peak;
+                    std::atomic<types::size>    allocations;
+                    std::atomic<types::size>    deallocations;
+                    std::atomic<types::size>    reallocations;
+                    std::atomic<types::size>    copied;
+                    std::atomic<types::size>    histogram[histogram_bins];
+                };
+
+                /**
+                 * Copy of the counters, taken at a given time.
+                 *
+                 * Counters are read one at the time, hence, a snapshot
+                 * taken while other threads allocate may be slightly
+                 * inconsistent.
+                 */
+                struct snapshot {
+                    types::size     live;
+                    types::size     peak;
+                    types::size     allocations;
+                    types::size     deallocations;
+                    types::size     reallocations;
+                    types::size     copied;
+                    types::size     histogram[histogram_bins];
+                };
+
+                /**
+                 * Allocator wrapper, keeping statistics of the requests
+                 * it forwards to its parent.
+                 *
+                 * Every block is prefixed by a small header holding its
+                 * size, so that freed bytes can be accounted for.
+                 *
+                 * @param ator V-table handed out to the clients
+                 * @param data Statistics of this allocator
+                 * @param parent Allocator requests are forwarded to
+                 * @note Thread-safe, as long as the parent allocator is.
+                 */
+                struct tracker {
+                    const allocator     ator;
+                    counters            data;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * Instantiate a new tracking allocator.
+                 *
+                 * @param parent Allocator requests are forwarded to
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                tracker* make(const allocator* parent = get_default_allocator());
+
+                /**
+                 * Release the tracking allocator.
+                 *
+                 * Blocks still allocated must be freed before this call.
+                 *
+                 * @param t Tracker to destroy, it will be set to null
+                 */
+                void destroy(tracker*& t);
+
+                /**
+                 * Get the allocator v-table of the given tracker.
+                 *
+                 * @param t Tracker to allocate from
+                 * @return Allocator operating on the given tracker
+                 */
+                inline const allocator* get_allocator(const tracker& t) {
+                    return &t.ator;
+                }
+
+                /**
+                 * Read the statistics of an allocator.
+                 *
+                 * Trackers are always instrumented, while the default
+                 * allocator, hence, the global memory functions, are only
+                 * when ANGIE_MEMORY_STATISTICS is defined. In that case,
+                 * sizes are the ones reported by `memory::size_of()`.
+                 *
+                 * @param ator Allocator to query
+                 * @param out Receives the statistics
+                 * @return true if the allocator is instrumented
+                 */
+                types::boolean query(const allocator* ator, snapshot& out);
+
+                /**
+                 * Periodically emit the global statistics.
+                 *
+                 * A background thread reports live and peak bytes,
+                 * allocation rate and reallocation copy volume, through
+                 * the given callback, at `level::performance`.
+                 *
+                 * @param cb Report callback function
+                 * @param period_ms Milliseconds between two reports
+                 * @return true if reporting started, false if statistics
+                 *      are not enabled, or reporting already started
+                 */
+                types::boolean start_report(system::report::callback* cb,
+                                            types::uint32 period_ms =
+                                            ANGIE_MEMORY_STATISTICS_PERIOD);
+
+                /**
+                 * Stop the periodic report, if started.
+                 */
+                void stop_report();
+
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/system/system.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace trim {
+
+                /**
+                 * Physical memory currently used by the process.
+                 *
+                 * @return Resident set size in bytes, 0 if unknown
+                 */
+                types::size get_resident_size();
+
+                /**
+                 * Start trimming global memory in the background.
+                 *
+                 * A background thread samples the resident set size, and
+                 * calls memory::flush() when it is above `target`, but only
+                 * while the process is idle, meaning memory didn't grow since
+                 * the previous sample. With ANGIE_MEMORY_STATISTICS, it also
+                 * waits for the free memory retained by the memory manager,
+                 * resident bytes not allocated, to be worth a flush.
+                 * Flushes giving back little memory make the thread back off,
+                 * up to 16 times the period, so that it doesn't keep calling
+                 * an expensive flush for nothing.
+                 *
+                 * @param cb Report callback, receiving the bytes trimmed
+                 *      at `level::performance`, it can be null
+                 * @param target Resident bytes below which nothing is done
+                 * @param period_ms Milliseconds between two samples
+                 * @return true if trimming started, false if the trimmer
+                 *      is not enabled, or it already started
+                 * @note Enabled when ANGIE_MEMORY_TRIMMER is defined.
+                 */
+                types::boolean start(system::report::callback* cb = nullptr,
+                                     types::size target =
+                                     ANGIE_MEMORY_TRIM_TARGET,
+                                     types::uint32 period_ms =
+                                     ANGIE_MEMORY_TRIM_PERIOD);
+
+                /**
+                 * Stop trimming, if started.
+                 */
+                void stop();
+
+                /**
+                 * Number of flushes issued by the background thread.
+                 */
+                types::size get_flushes();
+
+            }
+        }
+    }
+}
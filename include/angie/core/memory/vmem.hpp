@@ -0,0 +1,104 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/config.hpp"
+#include "angie/core/types.hpp"
+#include "angie/core/memory/allocator.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace vmem {
+
+                /**
+                 * Reserve/commit virtual memory allocator.
+                 *
+                 * Every block reserves `reserve` bytes of address space up
+                 * front, but only the pages actually used are committed.
+                 * Growing a block commits more pages after it, hence, the
+                 * pointer doesn't change, and no byte is copied, as long as
+                 * the new size fits into the reservation. Shrinking gives
+                 * the unused pages back to the system.
+                 *
+                 * Requests smaller than a page are not worth a reservation,
+                 * they are forwarded to the parent allocator, until they
+                 * grow past that size.
+                 *
+                 * @param ator V-table handed out to the clients
+                 * @param reserve Address space reserved for each block
+                 * @param parent Allocator small blocks are served from
+                 * @note Thread-safe, as long as the parent allocator is.
+                 */
+                struct space {
+                    const allocator     ator;
+                    types::size         reserve;
+                    const allocator*    parent;
+                };
+
+                /**
+                 * Instantiate a new virtual memory allocator.
+                 *
+                 * @param reserve Bytes of address space reserved per block,
+                 *      rounded up to the page size. Blocks growing past it
+                 *      are moved into a bigger reservation.
+                 * @param parent Allocator used for the allocator itself and
+                 *      for blocks smaller than a page
+                 * @return Not null object on success, nullptr otherwise
+                 */
+                space* make(types::size reserve = ANGIE_MEMORY_VMEM_RESERVE,
+                            const allocator* parent = get_default_allocator());
+
+                /**
+                 * Release the allocator.
+                 *
+                 * Blocks still allocated are not released, and must be
+                 * freed before calling this function.
+                 *
+                 * @param s Allocator to destroy, it will be set to null
+                 */
+                void destroy(space*& s);
+
+                /**
+                 * Get the allocator v-table of the given space.
+                 *
+                 * @param s Space to allocate from
+                 * @return Allocator operating on the given space
+                 */
+                inline const allocator* get_allocator(const space& s) {
+                    return &s.ator;
+                }
+
+                /**
+                 * Size of the pages memory is committed by.
+                 *
+                 * @return Page size in bytes
+                 */
+                types::size get_page_size();
+
+                /**
+                 * Address space reserved for the given block.
+                 *
+                 * @param ptr Block allocated from a vmem allocator
+                 * @return Reserved bytes, 0 if the block is served
+                 *      by the parent allocator
+                 */
+                types::size get_reserved(const void* ptr);
+
+                /**
+                 * Physical memory committed for the given block.
+                 *
+                 * @param ptr Block allocated from a vmem allocator
+                 * @return Committed bytes, 0 if the block is served
+                 *      by the parent allocator
+                 */
+                types::size get_committed(const void* ptr);
+
+            }
+        }
+    }
+}
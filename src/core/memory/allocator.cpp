@@ -7,14 +7,43 @@
 #include "angie/core/memory/allocator.hpp"
 #include "angie/core/memory/global.hpp"
 
+namespace {
+
+    using namespace angie::core;
+
+    void* default_alloc(void*, types::size sz, types::size al) {
+        return memory::allocate(sz, al);
+    }
+
+    void default_free(void*, void* ptr) {
+        memory::deallocate(ptr);
+    }
+
+    void default_free_sized(void*, void* ptr, types::size sz) {
+        memory::deallocate(ptr, sz);
+    }
+
+    void* default_realloc(void*, void* ptr, types::size sz, types::size al) {
+        return memory::reallocate(ptr, sz, al);
+    }
+
+    types::boolean default_try_expand(void*, void* ptr, types::size sz) {
+        return memory::try_expand(ptr, sz);
+    }
+
+}
+
 namespace angie {
     namespace core {
         namespace memory {
 
             const allocator g_default_alloc = {
-                    memory::allocate,
-                    memory::deallocate,
-                    memory::reallocate,
+                    default_alloc,
+                    default_free,
+                    default_realloc,
+                    nullptr,
+                    default_try_expand,
+                    default_free_sized
             };
 
             const allocator* get_default_allocator() {
@@ -23,4 +52,4 @@ namespace angie {
 
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,271 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy/strcmp
+#include <mutex>
+#include <new>
+
+#include "angie/core/memory/budget.hpp"
+#include "angie/core/utils.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::budget::account;
+
+    /**
+     * Header preceding every block.
+     */
+    struct prefix {
+        types::size     size;
+        types::size     offset;
+    };
+
+    inline
+    prefix* prefix_of(void* ptr) {
+        return static_cast<prefix*>(ptr) - 1;
+    }
+
+    inline
+    types::size offset_of(types::size al) {
+        return al > sizeof(prefix) ? al : sizeof(prefix);
+    }
+
+    /**
+     * Registered accounts, guarded by the lock.
+     */
+    struct registry {
+        std::mutex      lock;
+        account*        head;
+    };
+
+    registry& get_registry() {
+        static registry r;
+        return r;
+    }
+
+    // Charge the account, unless it would go past the hard limit
+    bool charge(account* a, types::size bytes) {
+        types::size used = a->used.load(std::memory_order_relaxed);
+        do {
+            if (a->hard && (bytes > a->hard || used > a->hard - bytes)) {
+                a->failures.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!a->used.compare_exchange_weak(used, used + bytes,
+            std::memory_order_relaxed));
+
+        const types::size now = used + bytes;
+        types::size peak = a->peak.load(std::memory_order_relaxed);
+        while (now > peak && !a->peak.compare_exchange_weak(peak, now,
+            std::memory_order_relaxed)) {}
+
+        // Fire on the request crossing the limit only, and give the
+        // callback a chance to make room before the parent is asked.
+        if (a->on_pressure && a->soft && used <= a->soft && now > a->soft) {
+            a->on_pressure(*a, now, a->user_data);
+        }
+
+        return true;
+    }
+
+    inline
+    void refund(account* a, types::size bytes) {
+        a->used.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void* budget_alloc(void* ctx, types::size sz, types::size al) {
+        auto* a = static_cast<account*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        const types::size offset = offset_of(al);
+        if (sz > ~types::size(0) - offset || !charge(a, sz))
+            return nullptr;
+
+        auto* base = static_cast<types::byte*>(
+            memory::alloc(a->parent, offset + sz, al));
+
+        if (!base) {
+            refund(a, sz);
+            return nullptr;
+        }
+
+        void* ptr = base + offset;
+        *prefix_of(ptr) = { sz, offset };
+        return ptr;
+    }
+
+    void budget_free(void* ctx, void* ptr) {
+        auto* a = static_cast<account*>(ctx);
+
+        // The prefix knows the size, so the parent is freed by size,
+        // and there is no need for a sized entry of our own.
+        if (ptr) {
+            const prefix p = *prefix_of(ptr);
+            memory::dealloc(a->parent, static_cast<types::byte*>(ptr)
+                - p.offset, p.offset + p.size);
+            refund(a, p.size);
+        }
+    }
+
+    void* budget_realloc(void* ctx, void* ptr, types::size sz,
+                         types::size al) {
+        auto* a = static_cast<account*>(ctx);
+
+        if (!ptr) return budget_alloc(ctx, sz, al);
+        if (!sz) return budget_free(ctx, ptr), nullptr;
+
+        const prefix p = *prefix_of(ptr);
+        const types::size offset = al ? offset_of(al) : p.offset;
+        if (sz > ~types::size(0) - offset || (al && !utils::is_power_of_two(al)))
+            return nullptr;
+
+        // Growing blocks are charged upfront, in order to fail before
+        // anything happens, while shrinking ones are refunded after.
+        const types::size grow = sz > p.size ? sz - p.size : 0;
+        if (grow && !charge(a, grow)) {
+            return nullptr;
+        }
+
+        auto* base = static_cast<types::byte*>(ptr) - p.offset;
+        types::byte* nbase = nullptr;
+
+        if (offset == p.offset) {
+            nbase = static_cast<types::byte*>(
+                memory::realloc(a->parent, base, offset + sz, al));
+        } else {
+            nbase = static_cast<types::byte*>(
+                memory::alloc(a->parent, offset + sz, al));
+
+            if (nbase) {
+                memcpy(nbase + offset, ptr, p.size < sz ? p.size : sz);
+                memory::dealloc(a->parent, base);
+            }
+        }
+
+        if (!nbase) {
+            refund(a, grow);
+            return nullptr;
+        }
+
+        if (sz < p.size) {
+            refund(a, p.size - sz);
+        }
+
+        void* nptr = nbase + offset;
+        *prefix_of(nptr) = { sz, offset };
+        return nptr;
+    }
+
+    types::boolean budget_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* a = static_cast<account*>(ctx);
+        prefix* p = prefix_of(ptr);
+
+        if (sz <= p->size) {
+            return true;
+        }
+
+        const types::size grow = sz - p->size;
+        if (sz > ~types::size(0) - p->offset || !charge(a, grow)) {
+            return false;
+        }
+
+        if (!memory::try_expand(a->parent,
+                static_cast<types::byte*>(ptr) - p->offset, p->offset + sz)) {
+            refund(a, grow);
+            return false;
+        }
+
+        p->size = sz;
+        return true;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace budget {
+
+                account* make(const types::char8* name, types::size soft,
+                              types::size hard,
+                              pressure_callback* on_pressure, void* user_data,
+                              const allocator* parent) {
+                    if (!parent || !name)
+                        return nullptr;
+
+                    void* buffer = memory::alloc(parent,
+                        sizeof(account), alignof(account));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    auto* a = new(buffer) account {
+                        { budget_alloc, budget_free, budget_realloc,
+                          buffer, budget_try_expand, nullptr },
+                        name, soft, hard, on_pressure, user_data,
+                        {}, {}, {}, nullptr, parent
+                    };
+
+                    auto& r = get_registry();
+                    std::lock_guard<std::mutex> lock(r.lock);
+                    a->next = r.head;
+                    r.head = a;
+                    return a;
+                }
+
+                void destroy(account*& a) {
+                    if (a) {
+                        {
+                            auto& r = get_registry();
+                            std::lock_guard<std::mutex> lock(r.lock);
+
+                            account** link = &r.head;
+                            while (*link != a) {
+                                link = &(*link)->next;
+                            }
+
+                            *link = a->next;
+                        }
+
+                        const allocator* parent = a->parent;
+                        a->~account();
+                        memory::dealloc(parent, a);
+                        a = nullptr;
+                    }
+                }
+
+                account* find(const types::char8* name) {
+                    auto& r = get_registry();
+                    std::lock_guard<std::mutex> lock(r.lock);
+
+                    for (account* a = r.head; a; a = a->next) {
+                        if (!strcmp(a->name, name)) {
+                            return a;
+                        }
+                    }
+
+                    return nullptr;
+                }
+
+                void for_each(visitor* visit, void* user_data) {
+                    auto& r = get_registry();
+                    std::lock_guard<std::mutex> lock(r.lock);
+
+                    for (const account* a = r.head; a; a = a->next) {
+                        visit(*a, user_data);
+                    }
+                }
+
+            }
+        }
+    }
+}
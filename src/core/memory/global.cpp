@@ -7,28 +7,169 @@
 #include "angie/core/memory/global.hpp"
 #include "impl/global_impl.hpp"
 
+#ifdef ANGIE_MEMORY_THREAD_CACHE
+#include "impl/cache/thread_cache.hpp"
+#endif
+
+#ifdef ANGIE_MEMORY_STATISTICS
+#include "impl/stats_impl.hpp"
+#endif
+
+#ifdef ANGIE_MEMORY_PROFILER
+#include "impl/profiler_impl.hpp"
+#endif
+
 namespace angie {
     namespace core {
         namespace memory {
 
+            // Layer global functions forward to, either the
+            // thread cache, or straight to the implementation.
+#ifdef ANGIE_MEMORY_THREAD_CACHE
+            namespace front = impl::cache;
+#else
+            namespace front = impl;
+#endif
+
             void* allocate(types::size size, types::size align) {
-                return impl::allocate(size, align);
+                void* ptr = front::allocate(size, align);
+#ifdef ANGIE_MEMORY_STATISTICS
+                if (ptr) {
+                    impl::stats::on_allocate(impl::stats::g_global,
+                        size, front::size_of(ptr));
+                }
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                if (ptr) {
+                    impl::profiler::on_allocate(ptr, size);
+                }
+#endif
+                return ptr;
             }
 
             void deallocate(void* ptr) {
-                impl::deallocate(ptr);
+#ifdef ANGIE_MEMORY_STATISTICS
+                if (ptr) {
+                    impl::stats::on_deallocate(impl::stats::g_global,
+                        front::size_of(ptr));
+                }
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                impl::profiler::on_deallocate(ptr);
+#endif
+                front::deallocate(ptr);
+            }
+
+            void deallocate(void* ptr, types::size size) {
+#ifdef ANGIE_MEMORY_STATISTICS
+                if (ptr) {
+                    impl::stats::on_deallocate(impl::stats::g_global,
+                        front::size_of(ptr));
+                }
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                impl::profiler::on_deallocate(ptr);
+#endif
+                front::deallocate(ptr, size);
+            }
+
+            types::boolean allocate_n(void** ptrs, types::size count,
+                                      types::size size, types::size align) {
+                const types::size n = front::allocate_n(ptrs, count,
+                    size, align);
+
+                // All or nothing, give back what has been allocated
+                if (n < count) {
+                    front::deallocate_n(ptrs, n, size);
+                    return false;
+                }
+
+#if defined(ANGIE_MEMORY_STATISTICS) || defined(ANGIE_MEMORY_PROFILER)
+                for (types::size i = 0; i < count; ++i) {
+#ifdef ANGIE_MEMORY_STATISTICS
+                    impl::stats::on_allocate(impl::stats::g_global,
+                        size, front::size_of(ptrs[i]));
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                    impl::profiler::on_allocate(ptrs[i], size);
+#endif
+                }
+#endif
+                return true;
+            }
+
+            void deallocate_n(void** ptrs, types::size count,
+                              types::size size) {
+#if defined(ANGIE_MEMORY_STATISTICS) || defined(ANGIE_MEMORY_PROFILER)
+                for (types::size i = 0; i < count; ++i) {
+#ifdef ANGIE_MEMORY_STATISTICS
+                    if (ptrs[i]) {
+                        impl::stats::on_deallocate(impl::stats::g_global,
+                            front::size_of(ptrs[i]));
+                    }
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                    impl::profiler::on_deallocate(ptrs[i]);
+#endif
+                }
+#endif
+                front::deallocate_n(ptrs, count, size);
             }
 
             void* reallocate(void* ptr, types::size size, types::size align) {
-                return impl::reallocate(ptr, size, align);
+#if defined(ANGIE_MEMORY_STATISTICS) || defined(ANGIE_MEMORY_PROFILER)
+                if (!ptr) return allocate(size, align);
+                if (!size) return deallocate(ptr), nullptr;
+#endif
+#ifdef ANGIE_MEMORY_STATISTICS
+                const types::size old_size = front::size_of(ptr);
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                // Forget the old block before the backend can recycle
+                // its address, the new one gets its chance to be sampled.
+                impl::profiler::on_deallocate(ptr);
+#endif
+                void* nptr = front::reallocate(ptr, size, align);
+
+#ifdef ANGIE_MEMORY_STATISTICS
+                // When the block moves, the backend copies its content
+                if (nptr) {
+                    impl::stats::on_reallocate(impl::stats::g_global,
+                        old_size, front::size_of(nptr), nptr == ptr ? 0
+                        : (old_size < size ? old_size : size));
+                }
+#endif
+#ifdef ANGIE_MEMORY_PROFILER
+                if (nptr) {
+                    impl::profiler::on_allocate(nptr, size);
+                }
+#endif
+                return nptr;
+            }
+
+            types::boolean try_expand(void* ptr, types::size sz) {
+#ifdef ANGIE_MEMORY_STATISTICS
+                if (!ptr) return false;
+
+                const types::size old_size = front::size_of(ptr);
+                if (front::try_expand(ptr, sz)) {
+                    impl::stats::on_reallocate(impl::stats::g_global,
+                        old_size, front::size_of(ptr), 0);
+                    return true;
+                }
+
+                return false;
+#else
+                return front::try_expand(ptr, sz);
+#endif
             }
 
             void flush() {
-                impl::flush();
+                front::flush();
             }
 
             types::size size_of(void *ptr) {
-                return impl::size_of(ptr);
+                return front::size_of(ptr);
             }
         }
     }
@@ -57,3 +198,17 @@ void operator delete  (void* p) {
 void operator delete[](void* p) {
     angie::core::memory::deallocate(p);
 }
+
+#ifdef __cpp_sized_deallocation
+/**
+ * Sized delete operators, the compiler passes the size of the
+ * object, sparing the memory manager to look the block up.
+ */
+void operator delete  (void* p, size_t size) {
+    angie::core::memory::deallocate(p, size);
+}
+
+void operator delete[](void* p, size_t size) {
+    angie::core::memory::deallocate(p, size);
+}
+#endif
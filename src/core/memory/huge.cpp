@@ -0,0 +1,266 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy
+#include <new>
+
+#include "angie/core/memory/huge.hpp"
+#include "angie/core/utils.hpp"
+#include "impl/virtual_impl.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::huge::heap;
+    namespace vm = memory::impl::vm;
+
+    /**
+     * Header preceding every block.
+     *
+     * `base` and `mapped` describe the whole mapping, which is 0 for
+     * blocks served by the parent allocator, while `capacity` is the
+     * number of usable bytes starting from the block.
+     */
+    struct block {
+        types::byte*    base;
+        types::size     mapped;
+        types::size     capacity;
+        types::size     size;
+        types::size     page;
+        types::boolean  transparent;
+    };
+
+    inline
+    types::size round_up(types::size v, types::size al) {
+        return (v + (al - 1)) & ~(al - 1);
+    }
+
+    inline
+    types::byte* align_forward(types::byte* ptr, types::size al) {
+        return reinterpret_cast<types::byte*>(round_up(
+            reinterpret_cast<types::uintptr>(ptr), al));
+    }
+
+    inline
+    block* header_of(const void* ptr) {
+        return reinterpret_cast<block*>(const_cast<types::byte*>(
+            static_cast<const types::byte*>(ptr))) - 1;
+    }
+
+    void* finalize(types::byte* base, types::size mapped,
+                   types::byte* begin, types::size length, types::size al,
+                   types::size sz, types::size page, bool transparent) {
+        types::byte* ptr = align_forward(begin + sizeof(block), al);
+        *header_of(ptr) = {
+            base, mapped, static_cast<types::size>(begin + length - ptr),
+            sz, page, transparent
+        };
+
+        return ptr;
+    }
+
+    void* map_huge(types::size sz, types::size al) {
+        const types::size hp = vm::large_page_size();
+        if (!hp || al > hp) {
+            return nullptr;
+        }
+
+        const types::size length = round_up(
+            round_up(sizeof(block), al) + sz, hp);
+
+        if (auto* base = static_cast<types::byte*>(
+                vm::allocate_large(length))) {
+            return finalize(base, length, base, length, al, sz, hp, false);
+        }
+
+        // The mapping has to be aligned to the huge page size, in
+        // order for the system to back it by huge pages.
+        const types::size mapped = length + hp;
+        auto* base = static_cast<types::byte*>(vm::reserve(mapped));
+        if (!base) {
+            return nullptr;
+        }
+
+        types::byte* begin = align_forward(base, hp);
+        if (!vm::commit(begin, length)) {
+            vm::release(base, mapped);
+            return nullptr;
+        }
+
+        const bool advised = vm::advise_large(begin, length);
+        return finalize(base, mapped, begin, length, al, sz,
+            advised ? hp : vm::page_size(), advised);
+    }
+
+    void* map_pages(types::size sz, types::size al) {
+        const types::size page = vm::page_size();
+        const types::size mapped = round_up(round_up(sizeof(block), al)
+            + sz + (al > page ? al : 0), page);
+
+        auto* base = static_cast<types::byte*>(vm::reserve(mapped));
+        if (!base) {
+            return nullptr;
+        }
+
+        if (!vm::commit(base, mapped)) {
+            vm::release(base, mapped);
+            return nullptr;
+        }
+
+        return finalize(base, mapped, base, mapped, al, sz, page, false);
+    }
+
+    void* huge_alloc(void* ctx, types::size sz, types::size al) {
+        auto* h = static_cast<heap*>(ctx);
+
+        if (al < ANGIE_DEFAULT_MEMORY_ALIGNMENT)
+            al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+
+        // Guard the size computations below against overflow
+        const types::size half = ~types::size(0) >> 1;
+        if (!sz || !utils::is_power_of_two(al) || sz > half || al > half) {
+            return nullptr;
+        }
+
+        const types::size offset = round_up(sizeof(block), al);
+        if (sz < h->threshold) {
+            auto* base = static_cast<types::byte*>(
+                memory::alloc(h->parent, offset + sz, al));
+
+            if (!base) {
+                return nullptr;
+            }
+
+            types::byte* ptr = base + offset;
+            *header_of(ptr) = { base, 0, sz, sz, 0, false };
+            return ptr;
+        }
+
+        if (void* ptr = map_huge(sz, al)) {
+            return ptr;
+        }
+
+        return map_pages(sz, al);
+    }
+
+    void huge_free(void* ctx, void* ptr) {
+        auto* h = static_cast<heap*>(ctx);
+
+        if (!ptr) {
+            return;
+        }
+
+        const block* b = header_of(ptr);
+        if (b->mapped) {
+            vm::release(b->base, b->mapped);
+        } else {
+            memory::dealloc(h->parent, b->base);
+        }
+    }
+
+    void* huge_realloc(void* ctx, void* ptr, types::size sz,
+                       types::size al) {
+        if (!ptr) return huge_alloc(ctx, sz, al);
+        if (!sz) return huge_free(ctx, ptr), nullptr;
+
+        block* b = header_of(ptr);
+        if (sz <= b->capacity && (!al || angie_is_aligned(ptr, al))) {
+            b->size = sz;
+            return ptr;
+        }
+
+        // Keep the alignment of the original block, if none is given,
+        // it can't be smaller than the one requested at allocation time.
+        if (!al) {
+            al = utils::alignment_of(reinterpret_cast<types::uintptr>(ptr));
+            if (al > vm::page_size()) al = vm::page_size();
+        }
+
+        void* nptr = huge_alloc(ctx, sz, al);
+        if (nptr) {
+            memcpy(nptr, ptr, b->size < sz ? b->size : sz);
+            huge_free(ctx, ptr);
+        }
+
+        return nptr;
+    }
+
+    types::boolean huge_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* h = static_cast<heap*>(ctx);
+        block* b = header_of(ptr);
+
+        if (sz > b->capacity) {
+            // Mapped blocks are committed all at once, while the
+            // parent may have room after the ones it serves.
+            const auto offset = static_cast<types::size>(
+                static_cast<types::byte*>(ptr) - b->base);
+
+            if (b->mapped
+                || !memory::try_expand(h->parent, b->base, offset + sz)) {
+                return false;
+            }
+
+            b->capacity = sz;
+        }
+
+        if (sz > b->size) {
+            b->size = sz;
+        }
+
+        return true;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace huge {
+
+                heap* make(types::size threshold, const allocator* parent) {
+                    if (!parent)
+                        return nullptr;
+
+                    void* buffer = memory::alloc(parent,
+                        sizeof(heap), alignof(heap));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    return new(buffer) heap {
+                        { huge_alloc, huge_free, huge_realloc, buffer,
+                          huge_try_expand, nullptr },
+                        threshold, parent
+                    };
+                }
+
+                void destroy(heap*& h) {
+                    if (h) {
+                        const allocator* parent = h->parent;
+                        h->~heap();
+                        memory::dealloc(parent, h);
+                        h = nullptr;
+                    }
+                }
+
+                types::size get_huge_page_size() {
+                    return vm::large_page_size();
+                }
+
+                types::size page_size_of(const void* ptr) {
+                    return ptr ? header_of(ptr)->page : 0;
+                }
+
+                types::boolean is_transparent(const void* ptr) {
+                    return ptr && header_of(ptr)->transparent;
+                }
+
+            }
+        }
+    }
+}
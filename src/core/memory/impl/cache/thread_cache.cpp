@@ -0,0 +1,481 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstring> // memcpy
+#include <new>
+
+#include "thread_cache.hpp"
+#include "../global_impl.hpp"
+#include "angie/core/utils.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    namespace impl = angie::core::memory::impl;
+
+    // Blocks are carved out of spans, which are requested to the
+    // backend in chunks, in order to amortise alignment padding.
+    constexpr types::size span_shift = 16;
+    constexpr types::size span_size = types::size(1) << span_shift;
+    constexpr types::size chunk_spans = 16;
+    constexpr types::size span_header = 64;
+
+    // Power of two size classes, from 16 bytes to 8KB.
+    constexpr types::size min_block = 16;
+    constexpr types::size max_block = 8192;
+    constexpr types::size class_count = 10;
+
+    static_assert(max_block == min_block << (class_count - 1),
+        "Size classes must cover min to max block size");
+
+    // The page map tells whether an address belongs to a span. It is a
+    // two level radix tree indexed by span number, leaves are allocated
+    // on demand, while the root lives in the zero initialised data.
+#ifdef ANGIE_ARCH_64
+    constexpr types::size address_bits = 48;
+#else
+    constexpr types::size address_bits = 32;
+#endif
+    constexpr types::size key_bits = address_bits - span_shift;
+    constexpr types::size leaf_bits = key_bits < 16 ? key_bits : 16;
+    constexpr types::size root_bits = key_bits - leaf_bits;
+
+    struct leaf {
+        std::atomic<types::uint8> spans[types::size(1) << leaf_bits];
+    };
+
+    std::atomic<leaf*> g_root[types::size(1) << root_bits];
+
+    struct heap;
+
+    /**
+     * Header at the beginning of every span.
+     */
+    struct span {
+        heap*           owner;
+        types::size     block_size;
+    };
+
+    static_assert(sizeof(span) <= span_header, "Span header too big");
+
+    struct bin {
+        void*           free_list;
+        types::byte*    cursor;
+        types::byte*    cursor_end;
+    };
+
+    /**
+     * Thread owned set of bins.
+     *
+     * `remote` is written by other threads only, hence, it sits on
+     * its own cache line. Heaps are never released, when a thread
+     * exits its heap is parked into the abandoned list, and adopted
+     * by the next thread needing one.
+     */
+    struct heap {
+        bin                         bins[class_count];
+        alignas(64) std::atomic<void*>  remote;
+        heap*                       next;
+    };
+
+    // Spin lock guarding the span source, page map leaves and the
+    // list of abandoned heaps. None of these are on the fast path.
+    std::atomic_flag g_lock = ATOMIC_FLAG_INIT;
+    types::byte* g_span = nullptr;
+    types::byte* g_span_end = nullptr;
+    heap* g_abandoned = nullptr;
+
+    struct scoped_lock {
+        scoped_lock() {
+            while (g_lock.test_and_set(std::memory_order_acquire)) {}
+        }
+
+        ~scoped_lock() {
+            g_lock.clear(std::memory_order_release);
+        }
+    };
+
+    void abandon(heap* h);
+
+    struct heap_owner {
+        heap* h;
+        ~heap_owner() { abandon(h); }
+    };
+
+    thread_local heap* t_heap = nullptr;
+    thread_local bool t_finalized = false;
+    thread_local heap_owner t_owner;
+
+    inline
+    span* span_of(void* ptr) {
+        return reinterpret_cast<span*>(
+            reinterpret_cast<types::uintptr>(ptr) & ~(span_size - 1));
+    }
+
+    inline
+    types::size class_of(types::size n) {
+        types::size idx = 0;
+        types::size block = min_block;
+        while (block < n) {
+            block <<= 1;
+            ++idx;
+        }
+
+        return idx;
+    }
+
+    inline
+    bool is_cached(void* ptr) {
+        const types::uintptr key =
+            reinterpret_cast<types::uintptr>(ptr) >> span_shift;
+
+        if (key >> key_bits) {
+            return false;
+        }
+
+        leaf* l = g_root[key >> leaf_bits].load(std::memory_order_acquire);
+        return l && l->spans[key & ((types::uintptr(1) << leaf_bits) - 1)]
+            .load(std::memory_order_acquire);
+    }
+
+    // Must be called while holding the lock
+    bool register_span(types::byte* s) {
+        const types::uintptr key =
+            reinterpret_cast<types::uintptr>(s) >> span_shift;
+
+        if (key >> key_bits) {
+            return false;
+        }
+
+        auto& root = g_root[key >> leaf_bits];
+        leaf* l = root.load(std::memory_order_relaxed);
+        if (!l) {
+            void* mem = impl::allocate(sizeof(leaf), alignof(leaf));
+            if (!mem) {
+                return false;
+            }
+
+            l = new(mem) leaf();
+            root.store(l, std::memory_order_release);
+        }
+
+        l->spans[key & ((types::uintptr(1) << leaf_bits) - 1)]
+            .store(1, std::memory_order_release);
+        return true;
+    }
+
+    // Must be called while holding the lock, on registered spans only
+    void unregister_span(types::byte* s) {
+        const types::uintptr key =
+            reinterpret_cast<types::uintptr>(s) >> span_shift;
+
+        leaf* l = g_root[key >> leaf_bits].load(std::memory_order_relaxed);
+        l->spans[key & ((types::uintptr(1) << leaf_bits) - 1)]
+            .store(0, std::memory_order_release);
+    }
+
+    types::byte* next_span() {
+        scoped_lock lock;
+
+        if (g_span == g_span_end) {
+            auto* chunk = static_cast<types::byte*>(impl::allocate(
+                span_size * chunk_spans, span_size));
+
+            if (!chunk) {
+                return nullptr;
+            }
+
+            for (types::size i = 0; i < chunk_spans; ++i) {
+                if (!register_span(chunk + i * span_size)) {
+                    // The backend may hand out this memory again, so
+                    // spans registered so far must not claim it.
+                    while (i--) {
+                        unregister_span(chunk + i * span_size);
+                    }
+
+                    impl::deallocate(chunk);
+                    return nullptr;
+                }
+            }
+
+            g_span = chunk;
+            g_span_end = chunk + span_size * chunk_spans;
+        }
+
+        auto* s = g_span;
+        g_span += span_size;
+        return s;
+    }
+
+    heap* acquire_heap() {
+        // Thread-local destructors already ran for this thread
+        if (t_finalized) {
+            return nullptr;
+        }
+
+        heap* h = nullptr;
+        {
+            scoped_lock lock;
+            h = g_abandoned;
+            if (h) {
+                g_abandoned = h->next;
+            }
+        }
+
+        if (!h) {
+            void* mem = impl::allocate(sizeof(heap), alignof(heap));
+            if (!mem) {
+                return nullptr;
+            }
+
+            h = new(mem) heap();
+        }
+
+        // First access to the owner registers its destructor
+        t_owner.h = h;
+        t_heap = h;
+        return h;
+    }
+
+    void abandon(heap* h) {
+        t_heap = nullptr;
+        t_finalized = true;
+
+        if (h) {
+            scoped_lock lock;
+            h->next = g_abandoned;
+            g_abandoned = h;
+        }
+    }
+
+    inline
+    void push_local(heap* h, void* ptr, types::size block_size) {
+        auto& b = h->bins[class_of(block_size)];
+        *static_cast<void**>(ptr) = b.free_list;
+        b.free_list = ptr;
+    }
+
+    void push_remote(heap* h, void* ptr) {
+        void* head = h->remote.load(std::memory_order_relaxed);
+        do {
+            *static_cast<void**>(ptr) = head;
+        } while (!h->remote.compare_exchange_weak(head, ptr,
+            std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Only the owner pops, and it takes the whole list at
+    // once, therefore, the exchange is not subject to ABA.
+    void collect_remote(heap* h) {
+        void* ptr = h->remote.exchange(nullptr, std::memory_order_acquire);
+        while (ptr) {
+            void* next = *static_cast<void**>(ptr);
+            push_local(h, ptr, span_of(ptr)->block_size);
+            ptr = next;
+        }
+    }
+
+    // Pop a block of the given class, null if no span is left
+    void* pop_block(heap* h, types::size idx) {
+        auto& b = h->bins[idx];
+
+        if (!b.free_list && b.cursor == b.cursor_end) {
+            collect_remote(h);
+        }
+
+        if (void* ptr = b.free_list) {
+            b.free_list = *static_cast<void**>(ptr);
+            return ptr;
+        }
+
+        const types::size block = min_block << idx;
+        if (b.cursor == b.cursor_end) {
+            auto* s = next_span();
+            if (!s) {
+                return nullptr;
+            }
+
+            auto* header = reinterpret_cast<span*>(s);
+            header->owner = h;
+            header->block_size = block;
+
+            b.cursor = s + (block > span_header ? block : span_header);
+            b.cursor_end = s + span_size;
+        }
+
+        void* ptr = b.cursor;
+        b.cursor += block;
+        return ptr;
+    }
+
+    inline
+    void free_block(void* ptr) {
+        auto* s = span_of(ptr);
+        if (s->owner == t_heap) {
+            push_local(s->owner, ptr, s->block_size);
+        } else {
+            push_remote(s->owner, ptr);
+        }
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace cache {
+
+                    void* allocate(types::size size, types::size align) {
+                        if (align < min_block) align = min_block;
+
+                        const types::size n = size > align ? size : align;
+                        if (!size || n > max_block
+                            || !utils::is_power_of_two(align)) {
+                            return impl::allocate(size, align);
+                        }
+
+                        heap* h = t_heap;
+                        if (!h && !(h = acquire_heap())) {
+                            return impl::allocate(size, align);
+                        }
+
+                        if (void* ptr = pop_block(h, class_of(n))) {
+                            return ptr;
+                        }
+
+                        return impl::allocate(size, align);
+                    }
+
+                    void deallocate(void* ptr) {
+                        if (!ptr) {
+                            return;
+                        }
+
+                        if (!is_cached(ptr)) {
+                            impl::deallocate(ptr);
+                            return;
+                        }
+
+                        free_block(ptr);
+                    }
+
+                    void deallocate(void* ptr, types::size size) {
+                        if (!ptr) {
+                            return;
+                        }
+
+                        // No class is that big, skip the page map
+                        if (size > max_block || !is_cached(ptr)) {
+                            impl::deallocate(ptr, size);
+                            return;
+                        }
+
+                        free_block(ptr);
+                    }
+
+                    types::size allocate_n(void** ptrs, types::size count,
+                                           types::size size,
+                                           types::size align) {
+                        if (align < min_block) align = min_block;
+
+                        const types::size n = size > align ? size : align;
+                        heap* h = nullptr;
+                        if (!size || n > max_block
+                            || !utils::is_power_of_two(align)
+                            || (!(h = t_heap) && !(h = acquire_heap()))) {
+                            return impl::allocate_n(ptrs, count, size, align);
+                        }
+
+                        // Resolve heap and bin once, for the whole batch
+                        const types::size idx = class_of(n);
+                        types::size i = 0;
+                        while (i < count && (ptrs[i] = pop_block(h, idx))) {
+                            ++i;
+                        }
+
+                        return i + impl::allocate_n(ptrs + i, count - i,
+                            size, align);
+                    }
+
+                    void deallocate_n(void** ptrs, types::size count,
+                                      types::size size) {
+                        if (size > max_block) {
+                            impl::deallocate_n(ptrs, count, size);
+                            return;
+                        }
+
+                        for (types::size i = 0; i < count; ++i) {
+                            deallocate(ptrs[i], size);
+                        }
+                    }
+
+                    void* reallocate(void* ptr, types::size sz,
+                                     types::size al) {
+                        if (!ptr) return allocate(sz, al);
+                        if (!sz) return deallocate(ptr), nullptr;
+
+                        if (!is_cached(ptr)) {
+                            return impl::reallocate(ptr, sz, al);
+                        }
+
+                        const types::size osz = span_of(ptr)->block_size;
+                        if (sz <= osz && (!al || angie_is_aligned(ptr, al))) {
+                            return ptr;
+                        }
+
+                        // Keep the alignment of the original block, if none
+                        // is given, which is at least as big as the one
+                        // requested when it was allocated.
+                        if (!al) {
+                            al = utils::alignment_of(
+                                reinterpret_cast<types::uintptr>(ptr));
+                            if (al > osz) al = osz;
+                        }
+
+                        void* nptr = allocate(sz, al);
+                        if (nptr) {
+                            memcpy(nptr, ptr, osz < sz ? osz : sz);
+                            deallocate(ptr);
+                        }
+
+                        return nptr;
+                    }
+
+                    types::boolean try_expand(void* ptr, types::size sz) {
+                        if (!ptr) {
+                            return false;
+                        }
+
+                        // Cached blocks can't outgrow their size class
+                        if (is_cached(ptr)) {
+                            return sz <= span_of(ptr)->block_size;
+                        }
+
+                        return impl::try_expand(ptr, sz);
+                    }
+
+                    void flush() {
+                        if (heap* h = t_heap) {
+                            collect_remote(h);
+                        }
+
+                        impl::flush();
+                    }
+
+                    types::size size_of(void* ptr) {
+                        if (ptr && is_cached(ptr)) {
+                            return span_of(ptr)->block_size;
+                        }
+
+                        return impl::size_of(ptr);
+                    }
+
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/base.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace cache {
+
+                    /**
+                     * Per-thread caching layer in front of the global
+                     * memory implementation.
+                     *
+                     * Small blocks are served from thread-local bins, one per
+                     * power of two size class, carved out of spans requested
+                     * to impl::allocate(). A block freed by a thread other than
+                     * the owner is pushed to the owner lock-free remote list,
+                     * and recycled by the owner on its next cache miss.
+                     * Spans are retained for reuse and never returned to the
+                     * backend, while requests bigger than the biggest class
+                     * go straight to the backend.
+                     *
+                     * Functions share the contract of the ones in impl.
+                     */
+
+                    void* allocate(types::size size, types::size align);
+
+                    void deallocate(void* ptr);
+
+                    void deallocate(void* ptr, types::size size);
+
+                    types::size allocate_n(void** ptrs, types::size count,
+                                           types::size size,
+                                           types::size align);
+
+                    void deallocate_n(void** ptrs, types::size count,
+                                      types::size size);
+
+                    void* reallocate(void* ptr, types::size sz,
+                                     types::size al);
+
+                    types::boolean try_expand(void* ptr, types::size sz);
+
+                    void flush();
+
+                    types::size size_of(void* ptr);
+
+                }
+            }
+        }
+    }
+}
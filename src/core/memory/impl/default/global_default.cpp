@@ -130,11 +130,48 @@ namespace angie {
                     free_aligned(ptr);
                 }
 
+                void deallocate(void* ptr, types::size) {
+                    // free() has no use for the size, the original
+                    // malloc pointer is stored in front of the block.
+                    if (ptr) free_aligned(ptr);
+                }
+
+                types::size allocate_n(void** ptrs, types::size count,
+                                       types::size size, types::size align) {
+                    types::size n = 0;
+                    while (n < count
+                        && (ptrs[n] = alloc_aligned(size, align))) {
+                        ++n;
+                    }
+
+                    return n;
+                }
+
+                void deallocate_n(void** ptrs, types::size count,
+                                  types::size) {
+                    for (types::size i = 0; i < count; ++i) {
+                        if (ptrs[i]) free_aligned(ptrs[i]);
+                    }
+                }
+
                 void* reallocate(void* ptr, types::size sz, types::size al) {
                     return realloc_aligned(ptr, sz, al);
                 }
 
+                types::boolean try_expand(void* ptr, types::size sz) {
+                    // malloc() can't grow a block without moving it,
+                    // but there may be enough slack in the block.
+                    return ptr && sz <= get_available_memory(ptr);
+                }
+
                 void flush() {
+#if defined(__GLIBC__)
+                    // Give free pages at the top of the heap, and
+                    // the ones in the middle of it, back to the system.
+                    malloc_trim(0);
+#elif defined(ANGIE_CC_MSVC) || defined(ANGIE_CC_MINGW)
+                    _heapmin();
+#endif
                 }
 
                 types::size size_of(void* ptr) {
@@ -35,6 +35,42 @@ namespace angie {
                  */
                 void deallocate(void* ptr);
 
+                /**
+                 * Deallocate a global pointer whose size is known.
+                 *
+                 * @param ptr This pointer has to be allocated by allocate().
+                 * @param size Size passed to allocate(), or any size not
+                 * bigger than the one returned by size_of().
+                 * @note Thread-safe.
+                 */
+                void deallocate(void* ptr, types::size size);
+
+                /**
+                 * Allocate several blocks of the same size.
+                 *
+                 * @param ptrs Array receiving the pointers.
+                 * @param count Number of blocks to allocate.
+                 * @param size Number of adjacent bytes of every block.
+                 * @param align Every pointer will be aligned by this value.
+                 * @return Number of blocks allocated, stored at the
+                 * beginning of `ptrs`, it is less than `count` only if
+                 * the memory manager ran out of memory.
+                 * @note Thread-safe.
+                 */
+                types::size allocate_n(void** ptrs, types::size count,
+                                       types::size size, types::size align);
+
+                /**
+                 * Deallocate several blocks of the same size.
+                 *
+                 * @param ptrs Pointers to deallocate, they can be null.
+                 * @param count Number of pointers.
+                 * @param size Size of every block, as for deallocate().
+                 * @note Thread-safe.
+                 */
+                void deallocate_n(void** ptrs, types::size count,
+                                  types::size size);
+
                 /**
                  * Reallocate memory from the pointer provided.
                  *
@@ -49,6 +85,17 @@ namespace angie {
                  */
                 void* reallocate(void* ptr, types::size sz, types::size al);
 
+                /**
+                 * Grow the given pointer in place.
+                 *
+                 * @param ptr Memory pointer previously allocated
+                 * @param sz Least number of bytes the block must hold
+                 * @return true if `ptr` can hold `sz` bytes now, false
+                 * otherwise, in which case `ptr` is left untouched.
+                 * @note Thread-safe.
+                 */
+                types::boolean try_expand(void* ptr, types::size sz);
+
                 /**
                  * Flush global memory.
                  *
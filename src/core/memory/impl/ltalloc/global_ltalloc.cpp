@@ -44,6 +44,32 @@ namespace angie {
                     ltfree(ptr);
                 }
 
+                void deallocate(void* ptr, types::size) {
+                    // ltalloc finds the size class from the chunk
+                    // the pointer belongs to, no lookup to skip.
+                    ltfree(ptr);
+                }
+
+                types::size allocate_n(void** ptrs, types::size count,
+                                       types::size size, types::size align) {
+                    if (align < sizeof(types::uintptr))
+                        align = sizeof(types::uintptr);
+
+                    types::size n = 0;
+                    while (n < count && (ptrs[n] = ltmemalign(align, size))) {
+                        ++n;
+                    }
+
+                    return n;
+                }
+
+                void deallocate_n(void** ptrs, types::size count,
+                                  types::size) {
+                    for (types::size i = 0; i < count; ++i) {
+                        ltfree(ptrs[i]);
+                    }
+                }
+
                 void* reallocate(void* ptr, types::size sz, types::size al) {
                     // Handle special cases
                     if (!ptr) return ltmemalign(sz, al);
@@ -80,6 +106,12 @@ namespace angie {
                     return nptr;
                 }
 
+                types::boolean try_expand(void* ptr, types::size sz) {
+                    // Blocks are size classes, they can only grow
+                    // up to the size of the class they belong to.
+                    return ptr && sz <= ltmsize(ptr);
+                }
+
                 void flush() {
                     ltsqueeze(0);
                 }
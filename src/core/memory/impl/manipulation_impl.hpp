@@ -0,0 +1,62 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/base.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace manipulation {
+
+                    using copy_fn = void (void* ANGIE_RESTRICT dst,
+                                          const void* ANGIE_RESTRICT src,
+                                          types::size bytes);
+                    using set_fn = void (void* dst, types::byte value,
+                                         types::size bytes);
+                    using equal_fn = types::boolean (const void* dst,
+                                                     const void* src,
+                                                     types::size bytes);
+
+                    /**
+                     * Set of functions backing memory manipulation.
+                     *
+                     * Kernels share the contract of memory::copy(),
+                     * memory::set() and memory::is_equal(), except
+                     * for the returned value, and they never assert.
+                     */
+                    struct kernels {
+                        copy_fn*                copy;
+                        set_fn*                 set;
+                        equal_fn*               is_equal;
+                        const types::char8*     name;
+                    };
+
+                    /**
+                     * Query the CPU for the widest vector kernels it runs.
+                     *
+                     * It also finds the size of the last level cache,
+                     * beyond which copies and sets bypass the caches.
+                     * @return Vector kernels, or nullptr if the CPU
+                     * doesn't support any of them.
+                     */
+                    const kernels* select();
+
+                    /**
+                     * Set the size beyond which the vector kernels
+                     * bypass the caches.
+                     *
+                     * @return The previous size
+                     */
+                    types::size set_stream_threshold(types::size bytes);
+
+                }
+            }
+        }
+    }
+}
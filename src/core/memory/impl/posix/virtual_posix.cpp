@@ -0,0 +1,155 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstdio>
+#include <cstring> // strstr
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+#include "../virtual_impl.hpp"
+
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace vm {
+
+                    types::size page_size() {
+                        static const types::size sz =
+                            static_cast<types::size>(sysconf(_SC_PAGESIZE));
+                        return sz;
+                    }
+
+                    void* reserve(types::size size) {
+                        void* ptr = mmap(nullptr, size, PROT_NONE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                            -1, 0);
+
+                        return (ptr == MAP_FAILED) ? nullptr : ptr;
+                    }
+
+                    types::boolean commit(void* ptr, types::size size) {
+                        return mprotect(ptr, size,
+                            PROT_READ | PROT_WRITE) == 0;
+                    }
+
+                    void decommit(void* ptr, types::size size) {
+                        // Drop the pages first, so that the memory is given
+                        // back to the system, then forbid any access again.
+                        madvise(ptr, size, MADV_DONTNEED);
+                        mprotect(ptr, size, PROT_NONE);
+                    }
+
+                    void release(void* ptr, types::size size) {
+                        munmap(ptr, size);
+                    }
+
+                    types::size large_page_size() {
+                        static const types::size sz = [] {
+                            types::size kb = 0;
+#ifdef __linux__
+                            if (FILE* f = fopen("/proc/meminfo", "r")) {
+                                char line[128];
+                                while (fgets(line, sizeof(line), f)) {
+                                    unsigned long v = 0;
+                                    if (sscanf(line, "Hugepagesize: %lu kB",
+                                            &v) == 1) {
+                                        kb = static_cast<types::size>(v);
+                                        break;
+                                    }
+                                }
+
+                                fclose(f);
+                            }
+#endif
+                            return kb * 1024;
+                        }();
+
+                        return sz;
+                    }
+
+                    void* allocate_large(types::size size) {
+#ifdef MAP_HUGETLB
+                        void* ptr = mmap(nullptr, size,
+                            PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                            -1, 0);
+
+                        return (ptr == MAP_FAILED) ? nullptr : ptr;
+#else
+                        return (void)size, nullptr;
+#endif
+                    }
+
+                    types::boolean advise_large(void* ptr, types::size size) {
+#ifdef MADV_HUGEPAGE
+                        // The hint is accepted, but ignored, when
+                        // transparent huge pages are disabled.
+                        static const bool enabled = [] {
+                            bool on = true;
+                            if (FILE* f = fopen("/sys/kernel/mm/"
+                                    "transparent_hugepage/enabled", "r")) {
+                                char line[128] = {};
+                                if (fgets(line, sizeof(line), f)) {
+                                    on = !strstr(line, "[never]");
+                                }
+
+                                fclose(f);
+                            }
+
+                            return on;
+                        }();
+
+                        return enabled
+                            && madvise(ptr, size, MADV_HUGEPAGE) == 0;
+#else
+                        return (void)ptr, (void)size, false;
+#endif
+                    }
+
+                    types::size resident_size() {
+#if defined(__linux__)
+                        // Second field of statm is the number of resident
+                        // pages, unlike getrusage(), which gives the peak.
+                        unsigned long pages = 0;
+                        if (FILE* f = fopen("/proc/self/statm", "r")) {
+                            if (fscanf(f, "%*u %lu", &pages) != 1) {
+                                pages = 0;
+                            }
+
+                            fclose(f);
+                        }
+
+                        return static_cast<types::size>(pages) * page_size();
+#elif defined(__APPLE__)
+                        mach_task_basic_info_data_t info;
+                        mach_msg_type_number_t count =
+                            MACH_TASK_BASIC_INFO_COUNT;
+                        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                                reinterpret_cast<task_info_t>(&info),
+                                &count) != KERN_SUCCESS) {
+                            return 0;
+                        }
+
+                        return static_cast<types::size>(info.resident_size);
+#else
+                        return 0;
+#endif
+                    }
+
+                }
+            }
+        }
+    }
+}
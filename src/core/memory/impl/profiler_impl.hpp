@@ -0,0 +1,73 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+
+#include "angie/core/memory/profiler.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace profiler {
+
+                    /**
+                     * Bytes left before the next sample on this thread.
+                     */
+                    extern thread_local types::int64 t_countdown;
+
+                    /**
+                     * Filter of the sampled blocks.
+                     *
+                     * Each slot counts the sampled blocks hashing to it,
+                     * so that most of the deallocations can tell they
+                     * have nothing to do, without taking any lock.
+                     */
+                    constexpr types::size filter_bits = 16;
+                    extern std::atomic<types::uint8>
+                        g_filter[types::size(1) << filter_bits];
+
+                    inline
+                    types::size filter_slot(const void* ptr) {
+                        const auto key = static_cast<types::uint64>(
+                            reinterpret_cast<types::uintptr>(ptr) >> 4);
+                        return static_cast<types::size>(
+                            (key * 0x9E3779B97F4A7C15ull) >> (64 - filter_bits));
+                    }
+
+                    /**
+                     * Capture the callstack of a sampled block.
+                     */
+                    void sample(void* ptr, types::size size);
+
+                    /**
+                     * Forget about a sampled block.
+                     */
+                    void forget(void* ptr);
+
+                    inline
+                    void on_allocate(void* ptr, types::size size) {
+                        if ((t_countdown -= static_cast<types::int64>(size))
+                            < 0) {
+                            sample(ptr, size);
+                        }
+                    }
+
+                    inline
+                    void on_deallocate(void* ptr) {
+                        if (ptr && g_filter[filter_slot(ptr)].load(
+                            std::memory_order_relaxed)) {
+                            forget(ptr);
+                        }
+                    }
+
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,490 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy/memset/memcmp
+
+#include "../manipulation_impl.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) \
+    || defined(__i386__) || defined(_M_IX86)
+#define ANGIE_MEMORY_SIMD_X86
+#endif
+
+#ifdef ANGIE_MEMORY_SIMD_X86
+
+#include <immintrin.h>
+
+#ifdef ANGIE_CC_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// Kernels are compiled for their own instruction set, regardless of the
+// one targeted by the rest of the library, they only run once the CPU
+// has been found to support it.
+#if defined(ANGIE_CC_GNU) || defined(ANGIE_CC_CLANG)
+#define ANGIE_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ANGIE_SIMD_TARGET(isa)
+#endif
+
+namespace {
+
+    using namespace angie::core;
+    namespace manip = memory::impl::manipulation;
+
+    // Below this size, the C library is as fast as it gets, while
+    // the vector loops would spend most of the time on the edges.
+    constexpr types::size small_bytes = 256;
+
+    // Copies and sets bigger than this bypass the caches, it is set
+    // to the size of the last level cache when the kernels are chosen.
+    types::size g_stream_bytes = ANGIE_MEMORY_STREAM_THRESHOLD;
+
+    inline
+    types::size skew_of(const void* ptr, types::size al) {
+        return al - (reinterpret_cast<types::uintptr>(ptr) & (al - 1));
+    }
+
+    // AVX2
+
+    ANGIE_SIMD_TARGET("avx2")
+    void copy_avx2(void* ANGIE_RESTRICT dst, const void* ANGIE_RESTRICT src,
+                   types::size bytes) {
+        if (bytes < small_bytes) {
+            memcpy(dst, src, bytes);
+            return;
+        }
+
+        auto* d = static_cast<types::byte*>(dst);
+        auto* s = static_cast<const types::byte*>(src);
+
+        // Copy the first vector unaligned, then carry on
+        // from the next 32 bytes boundary of the destination.
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+
+        const types::size skew = skew_of(d, 32);
+        const bool stream = bytes >= g_stream_bytes;
+        d += skew, s += skew, bytes -= skew;
+
+        for (; bytes >= 128; d += 128, s += 128, bytes -= 128) {
+            auto* vs = reinterpret_cast<const __m256i*>(s);
+            auto* vd = reinterpret_cast<__m256i*>(d);
+            const __m256i a = _mm256_loadu_si256(vs + 0);
+            const __m256i b = _mm256_loadu_si256(vs + 1);
+            const __m256i c = _mm256_loadu_si256(vs + 2);
+            const __m256i e = _mm256_loadu_si256(vs + 3);
+
+            if (stream) {
+                _mm256_stream_si256(vd + 0, a);
+                _mm256_stream_si256(vd + 1, b);
+                _mm256_stream_si256(vd + 2, c);
+                _mm256_stream_si256(vd + 3, e);
+            } else {
+                _mm256_store_si256(vd + 0, a);
+                _mm256_store_si256(vd + 1, b);
+                _mm256_store_si256(vd + 2, c);
+                _mm256_store_si256(vd + 3, e);
+            }
+        }
+
+        if (stream) {
+            _mm_sfence();
+        }
+
+        for (; bytes >= 32; d += 32, s += 32, bytes -= 32) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        }
+
+        // The last vector overlaps with the bytes already copied
+        if (bytes) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + bytes - 32),
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(s + bytes - 32)));
+        }
+    }
+
+    ANGIE_SIMD_TARGET("avx2")
+    void set_avx2(void* dst, types::byte value, types::size bytes) {
+        if (bytes < small_bytes) {
+            memset(dst, value, bytes);
+            return;
+        }
+
+        auto* d = static_cast<types::byte*>(dst);
+        const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+
+        const types::size skew = skew_of(d, 32);
+        const bool stream = bytes >= g_stream_bytes;
+        d += skew, bytes -= skew;
+
+        for (; bytes >= 128; d += 128, bytes -= 128) {
+            auto* vd = reinterpret_cast<__m256i*>(d);
+            if (stream) {
+                _mm256_stream_si256(vd + 0, v);
+                _mm256_stream_si256(vd + 1, v);
+                _mm256_stream_si256(vd + 2, v);
+                _mm256_stream_si256(vd + 3, v);
+            } else {
+                _mm256_store_si256(vd + 0, v);
+                _mm256_store_si256(vd + 1, v);
+                _mm256_store_si256(vd + 2, v);
+                _mm256_store_si256(vd + 3, v);
+            }
+        }
+
+        if (stream) {
+            _mm_sfence();
+        }
+
+        for (; bytes >= 32; d += 32, bytes -= 32) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(d), v);
+        }
+
+        if (bytes) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(d + bytes - 32), v);
+        }
+    }
+
+    ANGIE_SIMD_TARGET("avx2")
+    types::boolean is_equal_avx2(const void* dst, const void* src,
+                                 types::size bytes) {
+        if (bytes < 32) {
+            return memcmp(dst, src, bytes) == 0;
+        }
+
+        auto* a = static_cast<const types::byte*>(dst);
+        auto* b = static_cast<const types::byte*>(src);
+
+        for (; bytes >= 128; a += 128, b += 128, bytes -= 128) {
+            auto* va = reinterpret_cast<const __m256i*>(a);
+            auto* vb = reinterpret_cast<const __m256i*>(b);
+            const __m256i x = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_xor_si256(_mm256_loadu_si256(va + 0),
+                                     _mm256_loadu_si256(vb + 0)),
+                    _mm256_xor_si256(_mm256_loadu_si256(va + 1),
+                                     _mm256_loadu_si256(vb + 1))),
+                _mm256_or_si256(
+                    _mm256_xor_si256(_mm256_loadu_si256(va + 2),
+                                     _mm256_loadu_si256(vb + 2)),
+                    _mm256_xor_si256(_mm256_loadu_si256(va + 3),
+                                     _mm256_loadu_si256(vb + 3))));
+
+            if (!_mm256_testz_si256(x, x)) {
+                return false;
+            }
+        }
+
+        for (; bytes >= 32; a += 32, b += 32, bytes -= 32) {
+            const __m256i x = _mm256_xor_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+
+            if (!_mm256_testz_si256(x, x)) {
+                return false;
+            }
+        }
+
+        if (bytes) {
+            const __m256i x = _mm256_xor_si256(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(a + bytes - 32)),
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(b + bytes - 32)));
+
+            return _mm256_testz_si256(x, x) != 0;
+        }
+
+        return true;
+    }
+
+    // AVX-512
+
+    ANGIE_SIMD_TARGET("avx512f")
+    void copy_avx512(void* ANGIE_RESTRICT dst,
+                     const void* ANGIE_RESTRICT src, types::size bytes) {
+        if (bytes < small_bytes) {
+            memcpy(dst, src, bytes);
+            return;
+        }
+
+        auto* d = static_cast<types::byte*>(dst);
+        auto* s = static_cast<const types::byte*>(src);
+
+        _mm512_storeu_si512(d, _mm512_loadu_si512(s));
+
+        const types::size skew = skew_of(d, 64);
+        const bool stream = bytes >= g_stream_bytes;
+        d += skew, s += skew, bytes -= skew;
+
+        for (; bytes >= 256; d += 256, s += 256, bytes -= 256) {
+            const __m512i a = _mm512_loadu_si512(s + 0);
+            const __m512i b = _mm512_loadu_si512(s + 64);
+            const __m512i c = _mm512_loadu_si512(s + 128);
+            const __m512i e = _mm512_loadu_si512(s + 192);
+
+            if (stream) {
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 0), a);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), b);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), c);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), e);
+            } else {
+                _mm512_store_si512(d + 0, a);
+                _mm512_store_si512(d + 64, b);
+                _mm512_store_si512(d + 128, c);
+                _mm512_store_si512(d + 192, e);
+            }
+        }
+
+        if (stream) {
+            _mm_sfence();
+        }
+
+        for (; bytes >= 64; d += 64, s += 64, bytes -= 64) {
+            _mm512_store_si512(d, _mm512_loadu_si512(s));
+        }
+
+        if (bytes) {
+            _mm512_storeu_si512(d + bytes - 64,
+                _mm512_loadu_si512(s + bytes - 64));
+        }
+    }
+
+    ANGIE_SIMD_TARGET("avx512f")
+    void set_avx512(void* dst, types::byte value, types::size bytes) {
+        if (bytes < small_bytes) {
+            memset(dst, value, bytes);
+            return;
+        }
+
+        auto* d = static_cast<types::byte*>(dst);
+        const __m512i v = _mm512_set1_epi32(
+            static_cast<int>(0x01010101u * value));
+
+        _mm512_storeu_si512(d, v);
+
+        const types::size skew = skew_of(d, 64);
+        const bool stream = bytes >= g_stream_bytes;
+        d += skew, bytes -= skew;
+
+        for (; bytes >= 256; d += 256, bytes -= 256) {
+            if (stream) {
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 0), v);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), v);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), v);
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), v);
+            } else {
+                _mm512_store_si512(d + 0, v);
+                _mm512_store_si512(d + 64, v);
+                _mm512_store_si512(d + 128, v);
+                _mm512_store_si512(d + 192, v);
+            }
+        }
+
+        if (stream) {
+            _mm_sfence();
+        }
+
+        for (; bytes >= 64; d += 64, bytes -= 64) {
+            _mm512_store_si512(d, v);
+        }
+
+        if (bytes) {
+            _mm512_storeu_si512(d + bytes - 64, v);
+        }
+    }
+
+    ANGIE_SIMD_TARGET("avx512f")
+    types::boolean is_equal_avx512(const void* dst, const void* src,
+                                   types::size bytes) {
+        if (bytes < 64) {
+            return memcmp(dst, src, bytes) == 0;
+        }
+
+        auto* a = static_cast<const types::byte*>(dst);
+        auto* b = static_cast<const types::byte*>(src);
+
+        for (; bytes >= 256; a += 256, b += 256, bytes -= 256) {
+            const __m512i x = _mm512_or_si512(
+                _mm512_or_si512(
+                    _mm512_xor_si512(_mm512_loadu_si512(a + 0),
+                                     _mm512_loadu_si512(b + 0)),
+                    _mm512_xor_si512(_mm512_loadu_si512(a + 64),
+                                     _mm512_loadu_si512(b + 64))),
+                _mm512_or_si512(
+                    _mm512_xor_si512(_mm512_loadu_si512(a + 128),
+                                     _mm512_loadu_si512(b + 128)),
+                    _mm512_xor_si512(_mm512_loadu_si512(a + 192),
+                                     _mm512_loadu_si512(b + 192))));
+
+            if (_mm512_test_epi64_mask(x, x)) {
+                return false;
+            }
+        }
+
+        for (; bytes >= 64; a += 64, b += 64, bytes -= 64) {
+            if (_mm512_cmpneq_epi64_mask(_mm512_loadu_si512(a),
+                                         _mm512_loadu_si512(b))) {
+                return false;
+            }
+        }
+
+        return !bytes || !_mm512_cmpneq_epi64_mask(
+            _mm512_loadu_si512(a + bytes - 64),
+            _mm512_loadu_si512(b + bytes - 64));
+    }
+
+    const manip::kernels g_avx2 = {
+        copy_avx2, set_avx2, is_equal_avx2, "avx2"
+    };
+
+    const manip::kernels g_avx512 = {
+        copy_avx512, set_avx512, is_equal_avx512, "avx512"
+    };
+
+    // CPU queries
+
+    struct registers {
+        types::uint32 eax, ebx, ecx, edx;
+    };
+
+    registers cpuid(types::uint32 leaf, types::uint32 sub = 0) {
+        registers r = { 0, 0, 0, 0 };
+#ifdef ANGIE_CC_MSVC
+        int v[4];
+        __cpuidex(v, static_cast<int>(leaf), static_cast<int>(sub));
+        r = { types::uint32(v[0]), types::uint32(v[1]),
+              types::uint32(v[2]), types::uint32(v[3]) };
+#else
+        __cpuid_count(leaf, sub, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+        return r;
+    }
+
+    // Register state the operating system saves on context switches
+    types::uint64 xgetbv0() {
+#ifdef ANGIE_CC_MSVC
+        return _xgetbv(0);
+#else
+        types::uint32 lo, hi;
+        __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (types::uint64(hi) << 32) | lo;
+#endif
+    }
+
+    // Size of the biggest cache, from the deterministic cache
+    // parameters, leaf 4 on Intel, and 0x8000001D on AMD.
+    types::size last_level_cache(types::uint32 leaf) {
+        types::size biggest = 0;
+        for (types::uint32 sub = 0; sub < 16; ++sub) {
+            const registers r = cpuid(leaf, sub);
+            if (!(r.eax & 0x1f)) {
+                break;
+            }
+
+            const types::size ways = ((r.ebx >> 22) & 0x3ff) + 1;
+            const types::size partitions = ((r.ebx >> 12) & 0x3ff) + 1;
+            const types::size line = (r.ebx & 0xfff) + 1;
+            const types::size sets = types::size(r.ecx) + 1;
+            const types::size bytes = ways * partitions * line * sets;
+            if (bytes > biggest) {
+                biggest = bytes;
+            }
+        }
+
+        return biggest;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace manipulation {
+
+                    const kernels* select() {
+                        const types::uint32 max_leaf = cpuid(0).eax;
+                        const types::uint32 max_ext = cpuid(0x80000000).eax;
+
+                        types::size llc = max_leaf >= 4
+                            ? last_level_cache(4) : 0;
+                        if (!llc && max_ext >= 0x8000001D) {
+                            llc = last_level_cache(0x8000001D);
+                        }
+
+                        if (llc) {
+                            g_stream_bytes = llc;
+                        }
+
+                        if (max_leaf < 7) {
+                            return nullptr;
+                        }
+
+                        // The CPU must support the instructions, and the
+                        // operating system must preserve the registers.
+                        const registers id1 = cpuid(1);
+                        const bool osxsave = (id1.ecx & (1u << 27)) != 0;
+                        const types::uint64 xcr0 = osxsave ? xgetbv0() : 0;
+
+                        const registers id7 = cpuid(7);
+                        const bool ymm = (xcr0 & 0x6) == 0x6;
+                        const bool zmm = (xcr0 & 0xe6) == 0xe6;
+
+                        if (zmm && (id7.ebx & (1u << 16))) {
+                            return &g_avx512;
+                        }
+
+                        if (ymm && (id7.ebx & (1u << 5))) {
+                            return &g_avx2;
+                        }
+
+                        return nullptr;
+                    }
+
+                    types::size set_stream_threshold(types::size bytes) {
+                        const types::size previous = g_stream_bytes;
+                        g_stream_bytes = bytes;
+                        return previous;
+                    }
+
+                }
+            }
+        }
+    }
+}
+
+#else
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace manipulation {
+
+                    const kernels* select() {
+                        return nullptr;
+                    }
+
+                    // The C library kernels are the only ones available
+                    types::size set_stream_threshold(types::size) {
+                        return 0;
+                    }
+
+                }
+            }
+        }
+    }
+}
+
+#endif
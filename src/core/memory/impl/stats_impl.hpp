@@ -0,0 +1,84 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/memory/statistics.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace stats {
+
+                    using memory::stats::counters;
+
+                    /**
+                     * Counters of the global memory functions.
+                     */
+                    extern counters g_global;
+
+                    inline
+                    types::size bin_of(types::size size) {
+                        types::size idx = 0;
+                        types::size limit = 16;
+                        while (limit < size
+                               && idx < memory::stats::histogram_bins - 1) {
+                            limit <<= 1;
+                            ++idx;
+                        }
+
+                        return idx;
+                    }
+
+                    inline
+                    void add_live(counters& c, types::size bytes) {
+                        const types::size live = c.live.fetch_add(bytes,
+                            std::memory_order_relaxed) + bytes;
+
+                        types::size peak =
+                            c.peak.load(std::memory_order_relaxed);
+                        while (live > peak && !c.peak.compare_exchange_weak(
+                            peak, live, std::memory_order_relaxed)) {}
+                    }
+
+                    inline
+                    void on_allocate(counters& c, types::size request,
+                                     types::size bytes) {
+                        c.allocations.fetch_add(1, std::memory_order_relaxed);
+                        c.histogram[bin_of(request)].fetch_add(1,
+                            std::memory_order_relaxed);
+                        add_live(c, bytes);
+                    }
+
+                    inline
+                    void on_deallocate(counters& c, types::size bytes) {
+                        c.deallocations.fetch_add(1,
+                            std::memory_order_relaxed);
+                        c.live.fetch_sub(bytes, std::memory_order_relaxed);
+                    }
+
+                    inline
+                    void on_reallocate(counters& c, types::size old_bytes,
+                                       types::size new_bytes,
+                                       types::size copied) {
+                        c.reallocations.fetch_add(1,
+                            std::memory_order_relaxed);
+                        c.copied.fetch_add(copied, std::memory_order_relaxed);
+
+                        if (new_bytes > old_bytes) {
+                            add_live(c, new_bytes - old_bytes);
+                        } else {
+                            c.live.fetch_sub(old_bytes - new_bytes,
+                                std::memory_order_relaxed);
+                        }
+                    }
+
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,698 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstddef> // offsetof
+#include <cstdlib> // malloc/free
+#include <cstring> // memcpy
+
+#include "../global_impl.hpp"
+#include "angie/core/utils.hpp"
+
+// Two-Level Segregated Fit allocator, as described by M. Masmano et al.
+// "TLSF: a New Dynamic Memory Allocator for Real-Time Systems".
+//
+// Free blocks are kept in segregated lists, indexed by a first level
+// (power of two) and a second level (linear subdivision of the former),
+// with a bitmap per level. Finding a suitable free block, splitting and
+// merging with the physical neighbours are all constant time operations.
+
+namespace {
+
+    using namespace angie::core;
+
+#ifdef ANGIE_ARCH_64
+    constexpr types::size align_log2 = 3;
+    constexpr types::size fl_index_max = 32;
+#else
+    constexpr types::size align_log2 = 2;
+    constexpr types::size fl_index_max = 31;
+#endif
+
+    constexpr types::size align_size = types::size(1) << align_log2;
+
+    constexpr types::size sl_index_log2 = 5;
+    constexpr types::size sl_index_count = types::size(1) << sl_index_log2;
+    constexpr types::size fl_index_shift = sl_index_log2 + align_log2;
+    constexpr types::size fl_index_count = fl_index_max - fl_index_shift + 1;
+    constexpr types::size small_block_size =
+        types::size(1) << fl_index_shift;
+
+    /**
+     * Block header.
+     *
+     * `prev_phys` is only valid if the previous block is free, and it
+     * actually lives in the last word of the previous block payload.
+     * `next_free` and `prev_free` are only valid if the block is free.
+     * The two least significant bits of `size` hold the free flags.
+     */
+    struct block {
+        block*          prev_phys;
+        types::size     size;
+        block*          next_free;
+        block*          prev_free;
+    };
+
+    constexpr types::size free_bit = 1 << 0;
+    constexpr types::size prev_free_bit = 1 << 1;
+
+    constexpr types::size block_overhead = sizeof(types::size);
+    constexpr types::size block_start = offsetof(block, size)
+        + sizeof(types::size);
+
+    constexpr types::size block_size_min = sizeof(block) - sizeof(block*);
+    constexpr types::size block_size_max = types::size(1) << fl_index_max;
+
+    // User pointers of two adjacent blocks are `size + block_overhead`
+    // bytes apart, keeping every block size congruent to the overhead,
+    // modulo `ptr_align`, makes all of them naturally aligned to it.
+    constexpr types::size ptr_align = 2 * block_overhead;
+
+    static_assert(block_size_min % ptr_align == block_overhead,
+        "Minimum block size breaks the natural pointer alignment");
+
+    static_assert(sizeof(types::uint32) * 8 >= fl_index_count,
+        "First level bitmap too small");
+    static_assert(sizeof(types::uint32) * 8 >= sl_index_count,
+        "Second level bitmap too small");
+    static_assert(ANGIE_MAX_ALLOCATION_SIZE < block_size_max,
+        "Max allocation size exceeds the max block size");
+
+    /**
+     * Memory area requested to the system.
+     *
+     * Free blocks are carved out of the areas, which are linked together,
+     * so that they can be given back to the system when entirely free.
+     */
+    struct area {
+        area*           next;
+        types::size     size;
+        block*          first;
+    };
+
+    // Addresses are often aligned far beyond what was asked for, so the
+    // alignment kept by reallocations which don't ask for one is capped.
+    constexpr types::size realloc_align_max = 4096;
+
+    constexpr types::size area_header =
+        (sizeof(area) + align_size - 1) & ~(align_size - 1);
+
+    // Area header, plus the first block overhead and the sentinel block
+    constexpr types::size area_overhead = area_header + 2 * block_overhead;
+
+    struct control {
+        block           null_block;
+        types::uint32   fl_bitmap;
+        types::uint32   sl_bitmap[fl_index_count];
+        block*          blocks[fl_index_count][sl_index_count];
+        area*           areas;
+    };
+
+    control g_tlsf;
+    bool g_tlsf_ready = false;
+    std::atomic_flag g_lock = ATOMIC_FLAG_INIT;
+
+    struct scoped_lock {
+        scoped_lock() {
+            while (g_lock.test_and_set(std::memory_order_acquire)) {}
+        }
+
+        ~scoped_lock() {
+            g_lock.clear(std::memory_order_release);
+        }
+    };
+
+    inline int tlsf_ffs(types::uint32 v) {
+        types::uint32 r = 0;
+        angie_bsf(r, v);
+        return v ? static_cast<int>(r) : -1;
+    }
+
+    inline int tlsf_fls(types::uint32 v) {
+        types::uint32 r = 0;
+        angie_bsr(r, v);
+        return v ? static_cast<int>(r) : -1;
+    }
+
+    inline types::size align_up(types::size x, types::size al) {
+        return (x + (al - 1)) & ~(al - 1);
+    }
+
+    inline types::size align_down(types::size x, types::size al) {
+        return x - (x & (al - 1));
+    }
+
+    inline types::byte* align_ptr(types::byte* p, types::size al) {
+        return reinterpret_cast<types::byte*>(
+            align_up(reinterpret_cast<types::uintptr>(p), al));
+    }
+
+    // Block helpers
+
+    inline types::size block_size(const block* b) {
+        return b->size & ~(free_bit | prev_free_bit);
+    }
+
+    inline void block_set_size(block* b, types::size sz) {
+        b->size = sz | (b->size & (free_bit | prev_free_bit));
+    }
+
+    inline bool block_is_last(const block* b) {
+        return block_size(b) == 0;
+    }
+
+    inline bool block_is_free(const block* b) {
+        return (b->size & free_bit) != 0;
+    }
+
+    inline void block_set_free(block* b) { b->size |= free_bit; }
+    inline void block_set_used(block* b) { b->size &= ~free_bit; }
+
+    inline bool block_is_prev_free(const block* b) {
+        return (b->size & prev_free_bit) != 0;
+    }
+
+    inline void block_set_prev_free(block* b) { b->size |= prev_free_bit; }
+    inline void block_set_prev_used(block* b) { b->size &= ~prev_free_bit; }
+
+    inline block* block_from_ptr(void* ptr) {
+        return reinterpret_cast<block*>(
+            static_cast<types::byte*>(ptr) - block_start);
+    }
+
+    inline void* block_to_ptr(block* b) {
+        return reinterpret_cast<types::byte*>(b) + block_start;
+    }
+
+    inline block* offset_to_block(void* ptr, types::intptr offset) {
+        return reinterpret_cast<block*>(
+            static_cast<types::byte*>(ptr) + offset);
+    }
+
+    inline block* block_next(block* b) {
+        return offset_to_block(block_to_ptr(b),
+            static_cast<types::intptr>(block_size(b) - block_overhead));
+    }
+
+    inline block* block_link_next(block* b) {
+        block* next = block_next(b);
+        next->prev_phys = b;
+        return next;
+    }
+
+    inline void block_mark_as_free(block* b) {
+        block* next = block_link_next(b);
+        block_set_prev_free(next);
+        block_set_free(b);
+    }
+
+    inline void block_mark_as_used(block* b) {
+        block* next = block_next(b);
+        block_set_prev_used(next);
+        block_set_used(b);
+    }
+
+    // Returns zero if the request can't be satisfied
+    inline types::size adjust_request_size(types::size sz) {
+        if (sz && sz <= ANGIE_MAX_ALLOCATION_SIZE) {
+            const types::size aligned = align_up(sz + block_overhead,
+                ptr_align) - block_overhead;
+            return aligned < block_size_min ? block_size_min : aligned;
+        }
+
+        return 0;
+    }
+
+    // Mapping of sizes to first and second level indices
+
+    inline void mapping_insert(types::size sz, int& fl, int& sl) {
+        if (sz < small_block_size) {
+            fl = 0;
+            sl = static_cast<int>(sz / (small_block_size / sl_index_count));
+        } else {
+            fl = tlsf_fls(static_cast<types::uint32>(sz));
+            sl = static_cast<int>(sz >> (fl - sl_index_log2))
+                ^ (1 << sl_index_log2);
+            fl -= static_cast<int>(fl_index_shift - 1);
+        }
+    }
+
+    // Round up to the next list, so that any block found fits
+    inline void mapping_search(types::size sz, int& fl, int& sl) {
+        if (sz >= small_block_size) {
+            const types::size round = (types::size(1) << (tlsf_fls(
+                static_cast<types::uint32>(sz)) - sl_index_log2)) - 1;
+            sz += round;
+        }
+
+        mapping_insert(sz, fl, sl);
+    }
+
+    block* search_suitable_block(control& c, int& fl, int& sl) {
+        types::uint32 sl_map = c.sl_bitmap[fl] & (~0u << sl);
+        if (!sl_map) {
+            const types::uint32 fl_map = (fl + 1 < 32)
+                ? c.fl_bitmap & (~0u << (fl + 1)) : 0;
+
+            if (!fl_map) {
+                return nullptr;
+            }
+
+            fl = tlsf_ffs(fl_map);
+            sl_map = c.sl_bitmap[fl];
+        }
+
+        sl = tlsf_ffs(sl_map);
+        return c.blocks[fl][sl];
+    }
+
+    void remove_free_block(control& c, block* b, int fl, int sl) {
+        block* prev = b->prev_free;
+        block* next = b->next_free;
+        next->prev_free = prev;
+        prev->next_free = next;
+
+        if (c.blocks[fl][sl] == b) {
+            c.blocks[fl][sl] = next;
+
+            if (next == &c.null_block) {
+                c.sl_bitmap[fl] &= ~(1u << sl);
+                if (!c.sl_bitmap[fl]) {
+                    c.fl_bitmap &= ~(1u << fl);
+                }
+            }
+        }
+    }
+
+    void insert_free_block(control& c, block* b, int fl, int sl) {
+        block* current = c.blocks[fl][sl];
+        b->next_free = current;
+        b->prev_free = &c.null_block;
+        current->prev_free = b;
+
+        c.blocks[fl][sl] = b;
+        c.fl_bitmap |= (1u << fl);
+        c.sl_bitmap[fl] |= (1u << sl);
+    }
+
+    inline void block_remove(control& c, block* b) {
+        int fl, sl;
+        mapping_insert(block_size(b), fl, sl);
+        remove_free_block(c, b, fl, sl);
+    }
+
+    inline void block_insert(control& c, block* b) {
+        int fl, sl;
+        mapping_insert(block_size(b), fl, sl);
+        insert_free_block(c, b, fl, sl);
+    }
+
+    inline bool block_can_split(block* b, types::size sz) {
+        return block_size(b) >= sizeof(block) + sz;
+    }
+
+    block* block_split(block* b, types::size sz) {
+        block* remaining = offset_to_block(block_to_ptr(b),
+            static_cast<types::intptr>(sz - block_overhead));
+
+        const types::size remain_size = block_size(b)
+            - (sz + block_overhead);
+
+        block_set_size(remaining, remain_size);
+        block_set_size(b, sz);
+        block_mark_as_free(remaining);
+
+        return remaining;
+    }
+
+    block* block_absorb(block* prev, block* b) {
+        prev->size += block_size(b) + block_overhead;
+        block_link_next(prev);
+        return prev;
+    }
+
+    block* block_merge_prev(control& c, block* b) {
+        if (block_is_prev_free(b)) {
+            block* prev = b->prev_phys;
+            block_remove(c, prev);
+            b = block_absorb(prev, b);
+        }
+
+        return b;
+    }
+
+    block* block_merge_next(control& c, block* b) {
+        block* next = block_next(b);
+        if (block_is_free(next)) {
+            block_remove(c, next);
+            b = block_absorb(b, next);
+        }
+
+        return b;
+    }
+
+    void block_trim_free(control& c, block* b, types::size sz) {
+        if (block_can_split(b, sz)) {
+            block* remaining = block_split(b, sz);
+            block_link_next(b);
+            block_set_prev_free(remaining);
+            block_insert(c, remaining);
+        }
+    }
+
+    void block_trim_used(control& c, block* b, types::size sz) {
+        if (block_can_split(b, sz)) {
+            block* remaining = block_split(b, sz);
+            block_set_prev_used(remaining);
+            remaining = block_merge_next(c, remaining);
+            block_insert(c, remaining);
+        }
+    }
+
+    block* block_trim_free_leading(control& c, block* b, types::size sz) {
+        block* remaining = b;
+        if (block_can_split(b, sz)) {
+            remaining = block_split(b, sz - block_overhead);
+            block_set_prev_free(remaining);
+            block_link_next(b);
+            block_insert(c, b);
+        }
+
+        return remaining;
+    }
+
+    block* block_locate_free(control& c, types::size sz) {
+        int fl = 0, sl = 0;
+        block* b = nullptr;
+
+        if (sz) {
+            mapping_search(sz, fl, sl);
+
+            if (fl < static_cast<int>(fl_index_count)) {
+                b = search_suitable_block(c, fl, sl);
+            }
+        }
+
+        if (b) {
+            remove_free_block(c, b, fl, sl);
+        }
+
+        return b;
+    }
+
+    void* block_prepare_used(control& c, block* b, types::size sz) {
+        if (b) {
+            block_trim_free(c, b, sz);
+            block_mark_as_used(b);
+            return block_to_ptr(b);
+        }
+
+        return nullptr;
+    }
+
+    // Areas
+
+    void control_init(control& c) {
+        c.null_block.next_free = &c.null_block;
+        c.null_block.prev_free = &c.null_block;
+
+        c.fl_bitmap = 0;
+        for (types::size i = 0; i < fl_index_count; ++i) {
+            c.sl_bitmap[i] = 0;
+            for (types::size j = 0; j < sl_index_count; ++j) {
+                c.blocks[i][j] = &c.null_block;
+            }
+        }
+
+        c.areas = nullptr;
+    }
+
+    // Returns the free block spanning the new area, not in any list,
+    // which is big enough for `request`, or null if malloc fails.
+    block* add_area(control& c, types::size request) {
+        // The payload might need to move forward for the pointer alignment
+        types::size bytes = request + area_overhead + ptr_align;
+        if (bytes < ANGIE_MEMORY_TLSF_AREA_SIZE) {
+            bytes = ANGIE_MEMORY_TLSF_AREA_SIZE;
+        }
+
+        auto* memory = static_cast<types::byte*>(malloc(bytes));
+        if (!memory) {
+            return nullptr;
+        }
+
+        // The first block is placed so that its `size` field starts at
+        // the area payload, its `prev_phys` would overlap with the area
+        // header, but it is never accessed as nothing precedes it.
+        types::byte* payload = align_ptr(memory + area_header
+            + block_overhead, ptr_align) - block_overhead;
+        const types::size available = bytes
+            - static_cast<types::size>(payload - memory)
+            - 2 * block_overhead;
+        const types::size pool_bytes = align_down(
+            available - block_overhead, ptr_align) + block_overhead;
+
+        block* b = offset_to_block(payload,
+            -static_cast<types::intptr>(block_overhead));
+        b->size = 0;
+        block_set_size(b, pool_bytes);
+        block_set_free(b);
+        block_set_prev_used(b);
+
+        // Sentinel block, zero size, marked as used
+        block* next = block_link_next(b);
+        next->size = 0;
+        block_set_used(next);
+        block_set_prev_free(next);
+
+        auto* a = reinterpret_cast<area*>(memory);
+        a->next = c.areas;
+        a->size = pool_bytes;
+        a->first = b;
+        c.areas = a;
+
+        return b;
+    }
+
+    // Must be called while holding the lock
+    control& get_control() {
+        if (!g_tlsf_ready) {
+            control_init(g_tlsf);
+            g_tlsf_ready = true;
+        }
+
+        return g_tlsf;
+    }
+
+    void* tlsf_memalign(control& c, types::size al, types::size sz) {
+        const types::size adjust = adjust_request_size(sz);
+        if (!adjust) {
+            return nullptr;
+        }
+
+        // We must leave room for a free block in front of the aligned
+        // one, that's why the minimum gap is as big as a block header.
+        const types::size gap_minimum = sizeof(block);
+        const types::size aligned_size = (al > ptr_align)
+            ? adjust_request_size(adjust + al + gap_minimum)
+            : adjust;
+
+        if (!aligned_size) {
+            return nullptr;
+        }
+
+        // Searching rounds the size up to the next list, which the new
+        // area might not reach, so its block is taken directly instead.
+        block* b = block_locate_free(c, aligned_size);
+        if (!b && !(b = add_area(c, aligned_size))) {
+            return nullptr;
+        }
+
+        if (b && al > ptr_align) {
+            auto* ptr = static_cast<types::byte*>(block_to_ptr(b));
+            types::byte* aligned = align_ptr(ptr, al);
+            types::size gap = static_cast<types::size>(aligned - ptr);
+
+            // If the gap is too small to hold a free block, then,
+            // move to the next aligned position.
+            if (gap && gap < gap_minimum) {
+                const types::size gap_remain = gap_minimum - gap;
+                const types::size offset = gap_remain > al ? gap_remain : al;
+                aligned = align_ptr(aligned + offset, al);
+                gap = static_cast<types::size>(aligned - ptr);
+            }
+
+            if (gap) {
+                b = block_trim_free_leading(c, b, gap);
+            }
+        }
+
+        return block_prepare_used(c, b, adjust);
+    }
+
+    void tlsf_free(control& c, void* ptr) {
+        block* b = block_from_ptr(ptr);
+        block_mark_as_free(b);
+        b = block_merge_prev(c, b);
+        b = block_merge_next(c, b);
+        block_insert(c, b);
+    }
+
+    // Grow, or shrink, the block in place, if possible
+    bool tlsf_resize(control& c, void* ptr, types::size sz) {
+        block* b = block_from_ptr(ptr);
+        block* next = block_next(b);
+
+        const types::size cursize = block_size(b);
+        const types::size combined = cursize + block_size(next)
+            + block_overhead;
+        const types::size adjust = adjust_request_size(sz);
+
+        if (!adjust || (adjust > cursize
+            && (!block_is_free(next) || adjust > combined))) {
+            return false;
+        }
+
+        if (adjust > cursize) {
+            block_merge_next(c, b);
+            block_mark_as_used(b);
+        }
+
+        block_trim_used(c, b, adjust);
+        return true;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+
+                void* allocate(types::size sz, types::size al) {
+                    if (!utils::is_power_of_two(al) && al)
+                        return nullptr;
+
+                    scoped_lock lock;
+                    return tlsf_memalign(get_control(), al, sz);
+                }
+
+                void deallocate(void* ptr) {
+                    if (!ptr) return;
+
+                    scoped_lock lock;
+                    tlsf_free(get_control(), ptr);
+                }
+
+                void deallocate(void* ptr, types::size) {
+                    // The block header is needed to merge with the
+                    // neighbours anyway, and it holds the size.
+                    deallocate(ptr);
+                }
+
+                types::size allocate_n(void** ptrs, types::size count,
+                                       types::size size, types::size align) {
+                    if (!utils::is_power_of_two(align) && align)
+                        return 0;
+
+                    // Take the lock once for the whole batch
+                    scoped_lock lock;
+                    auto& c = get_control();
+
+                    types::size n = 0;
+                    while (n < count
+                        && (ptrs[n] = tlsf_memalign(c, align, size))) {
+                        ++n;
+                    }
+
+                    return n;
+                }
+
+                void deallocate_n(void** ptrs, types::size count,
+                                  types::size) {
+                    scoped_lock lock;
+                    auto& c = get_control();
+
+                    for (types::size i = 0; i < count; ++i) {
+                        if (ptrs[i]) tlsf_free(c, ptrs[i]);
+                    }
+                }
+
+                void* reallocate(void* ptr, types::size sz, types::size al) {
+                    // Handle special cases
+                    if (!ptr) return allocate(sz, al);
+                    if (!sz) return deallocate(ptr), nullptr;
+
+                    if (al && !utils::is_power_of_two(al))
+                        return nullptr;
+
+                    const types::size oal = utils::alignment_of(
+                        reinterpret_cast<types::uintptr>(ptr));
+
+                    scoped_lock lock;
+                    auto& c = get_control();
+
+                    // Memory can stay where it is, if it satisfies the
+                    // alignment, and there is enough room around it.
+                    if (oal >= al && tlsf_resize(c, ptr, sz)) {
+                        return ptr;
+                    }
+
+                    // Keep the alignment of the original block, if none
+                    // is given, up to a page, as it is likely accidental.
+                    const types::size osz = block_size(block_from_ptr(ptr));
+                    const types::size nal = al ? al : (oal < realloc_align_max
+                        ? oal : realloc_align_max);
+
+                    // A null pointer is returned in case of failure,
+                    // and the original pointer is left untouched.
+                    void* nptr = tlsf_memalign(c, nal, sz);
+                    if (nptr) {
+                        memcpy(nptr, ptr, osz < sz ? osz : sz);
+                        tlsf_free(c, ptr);
+                    }
+
+                    return nptr;
+                }
+
+                types::boolean try_expand(void* ptr, types::size sz) {
+                    if (!ptr) return false;
+
+                    scoped_lock lock;
+                    auto& c = get_control();
+
+                    // Never shrink, merge the next block only if needed
+                    return sz <= block_size(block_from_ptr(ptr))
+                        || tlsf_resize(c, ptr, sz);
+                }
+
+                void flush() {
+                    scoped_lock lock;
+                    auto& c = get_control();
+
+                    // Give back to the system every area which
+                    // is made of one single free block.
+                    area** link = &c.areas;
+                    while (area* a = *link) {
+                        block* b = a->first;
+                        if (block_is_free(b) && block_size(b) == a->size) {
+                            block_remove(c, b);
+                            *link = a->next;
+                            free(a);
+                        } else {
+                            link = &a->next;
+                        }
+                    }
+                }
+
+                types::size size_of(void* ptr) {
+                    return ptr ? block_size(block_from_ptr(ptr)) : 0;
+                }
+
+            }
+        }
+    }
+}
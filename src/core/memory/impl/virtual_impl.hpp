@@ -0,0 +1,98 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "angie/core/base.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace vm {
+
+                    /**
+                     * Granularity of the virtual memory operations.
+                     *
+                     * @return Size of a page in bytes
+                     */
+                    types::size page_size();
+
+                    /**
+                     * Reserve a range of the address space.
+                     *
+                     * Reserved memory can't be accessed until committed.
+                     * @param size Number of bytes, multiple of page size
+                     * @return Base address of the range, nullptr on failure
+                     */
+                    void* reserve(types::size size);
+
+                    /**
+                     * Back a reserved range with physical memory.
+                     *
+                     * @param ptr Page aligned address within a reservation
+                     * @param size Number of bytes, multiple of page size
+                     * @return true if successful, false otherwise
+                     */
+                    types::boolean commit(void* ptr, types::size size);
+
+                    /**
+                     * Give back physical memory, keeping the reservation.
+                     *
+                     * @param ptr Page aligned address within a reservation
+                     * @param size Number of bytes, multiple of page size
+                     */
+                    void decommit(void* ptr, types::size size);
+
+                    /**
+                     * Release the whole reservation.
+                     *
+                     * @param ptr Base address returned by reserve()
+                     * @param size Number of bytes passed to reserve()
+                     */
+                    void release(void* ptr, types::size size);
+
+                    /**
+                     * Size of the large pages supported by the system.
+                     *
+                     * @return Large page size in bytes, 0 if not supported
+                     */
+                    types::size large_page_size();
+
+                    /**
+                     * Map committed memory explicitly backed by large pages.
+                     *
+                     * Large pages must be reserved by the system, or the
+                     * process needs the right privileges, for this to work.
+                     * The memory is released by release().
+                     *
+                     * @param size Number of bytes, multiple of large page size
+                     * @return Base address of the range, nullptr on failure
+                     */
+                    void* allocate_large(types::size size);
+
+                    /**
+                     * Hint the system to back a committed range with large
+                     * pages, whenever it can (transparent huge pages).
+                     *
+                     * @param ptr Large page aligned address
+                     * @param size Number of bytes, multiple of large page size
+                     * @return true if the hint has been accepted
+                     */
+                    types::boolean advise_large(void* ptr, types::size size);
+
+                    /**
+                     * Physical memory currently used by the process.
+                     *
+                     * @return Resident set size in bytes, 0 if unknown
+                     */
+                    types::size resident_size();
+
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+
+#include "../virtual_impl.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace vm {
+
+                    types::size page_size() {
+                        static const types::size sz = [] {
+                            SYSTEM_INFO info;
+                            GetSystemInfo(&info);
+                            return static_cast<types::size>(info.dwPageSize);
+                        }();
+
+                        return sz;
+                    }
+
+                    void* reserve(types::size size) {
+                        return VirtualAlloc(nullptr, size, MEM_RESERVE,
+                            PAGE_NOACCESS);
+                    }
+
+                    types::boolean commit(void* ptr, types::size size) {
+                        return VirtualAlloc(ptr, size, MEM_COMMIT,
+                            PAGE_READWRITE) != nullptr;
+                    }
+
+                    void decommit(void* ptr, types::size size) {
+                        VirtualFree(ptr, size, MEM_DECOMMIT);
+                    }
+
+                    void release(void* ptr, types::size) {
+                        VirtualFree(ptr, 0, MEM_RELEASE);
+                    }
+
+                    types::size large_page_size() {
+                        static const types::size sz =
+                            static_cast<types::size>(GetLargePageMinimum());
+                        return sz;
+                    }
+
+                    void* allocate_large(types::size size) {
+                        // Requires the SeLockMemoryPrivilege to be granted
+                        // to the user, otherwise it simply fails.
+                        return VirtualAlloc(nullptr, size,
+                            MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                            PAGE_READWRITE);
+                    }
+
+                    types::boolean advise_large(void*, types::size) {
+                        // No transparent large pages on Windows
+                        return false;
+                    }
+
+                    types::size resident_size() {
+                        PROCESS_MEMORY_COUNTERS pmc;
+                        if (!GetProcessMemoryInfo(GetCurrentProcess(),
+                                &pmc, sizeof(pmc))) {
+                            return 0;
+                        }
+
+                        return static_cast<types::size>(pmc.WorkingSetSize);
+                    }
+
+                }
+            }
+        }
+    }
+}
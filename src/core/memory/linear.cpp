@@ -0,0 +1,163 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memmove
+#include <new>
+
+#include "angie/core/memory/linear.hpp"
+#include "angie/core/utils.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::linear::arena;
+
+    inline
+    types::byte* align_forward(types::byte* ptr, types::size al) {
+        return reinterpret_cast<types::byte*>(
+            (reinterpret_cast<types::uintptr>(ptr) + (al - 1)) & ~(al - 1));
+    }
+
+    void* linear_alloc(void* ctx, types::size sz, types::size al) {
+        auto* a = static_cast<arena*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        types::byte* ptr = align_forward(a->top, al);
+
+        // Check against the remaining space rather than computing
+        // `ptr + sz`, which could overflow for huge requests.
+        if (ptr > a->end || sz > static_cast<types::size>(a->end - ptr))
+            return nullptr;
+
+        a->top = ptr + sz;
+        a->last = ptr;
+        return ptr;
+    }
+
+    void linear_free(void* ctx, void* ptr) {
+        auto* a = static_cast<arena*>(ctx);
+
+        // Only the last block can be given back, any other
+        // one will be reclaimed by the next reset().
+        if (ptr && ptr == a->last) {
+            a->top = a->last;
+            a->last = nullptr;
+        }
+    }
+
+    void linear_free_sized(void* ctx, void* ptr, types::size sz) {
+        auto* a = static_cast<arena*>(ctx);
+
+        // Knowing the size, any block ending at the top can be given
+        // back, so blocks freed in reverse order are all reclaimed.
+        auto* bptr = static_cast<types::byte*>(ptr);
+        if (bptr && sz <= static_cast<types::size>(a->top - bptr)
+            && bptr + sz == a->top) {
+            a->top = bptr;
+            a->last = nullptr;
+        } else {
+            linear_free(ctx, ptr);
+        }
+    }
+
+    void* linear_realloc(void* ctx, void* ptr, types::size sz,
+                         types::size al) {
+        auto* a = static_cast<arena*>(ctx);
+
+        if (!ptr) return linear_alloc(ctx, sz, al);
+        if (!sz) return linear_free(ctx, ptr), nullptr;
+
+        auto* bptr = static_cast<types::byte*>(ptr);
+
+        // The last block can grow, or shrink, in place as long as
+        // its alignment still satisfies the requested one.
+        if (bptr == a->last && (!al || angie_is_aligned(bptr, al))
+            && sz <= static_cast<types::size>(a->end - bptr)) {
+            a->top = bptr + sz;
+            return ptr;
+        }
+
+        // We don't keep track of block sizes, but we know the old
+        // block can't extend past `top`, therefore, copying up to it
+        // is enough to carry over the whole content.
+        auto* old_top = a->top;
+        auto* nptr = static_cast<types::byte*>(linear_alloc(ctx, sz, al));
+        if (nptr) {
+            auto osz = static_cast<types::size>(old_top - bptr);
+            memmove(nptr, bptr, osz < sz ? osz : sz);
+        }
+
+        return nptr;
+    }
+
+    types::boolean linear_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* a = static_cast<arena*>(ctx);
+        auto* bptr = static_cast<types::byte*>(ptr);
+
+        // Only the last block knows where it ends, that's `top`
+        if (bptr != a->last || sz > static_cast<types::size>(a->end - bptr))
+            return false;
+
+        if (bptr + sz > a->top) {
+            a->top = bptr + sz;
+        }
+
+        return true;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace linear {
+
+                arena* make(types::size capacity, const allocator* parent) {
+                    if (!parent || !capacity)
+                        return nullptr;
+
+                    const types::size header = (sizeof(arena)
+                        + ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1)
+                        & ~types::size(ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1);
+
+                    auto* buffer = static_cast<types::byte*>(memory::alloc(
+                        parent, header + capacity,
+                        ANGIE_DEFAULT_MEMORY_ALIGNMENT));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    types::byte* begin = buffer + header;
+                    return new(buffer) arena {
+                        { linear_alloc, linear_free, linear_realloc, buffer,
+                          linear_try_expand, linear_free_sized },
+                        begin, begin, begin + capacity, nullptr, parent
+                    };
+                }
+
+                void destroy(arena*& a) {
+                    if (a) {
+                        const allocator* parent = a->parent;
+                        a->~arena();
+                        memory::dealloc(parent, a);
+                        a = nullptr;
+                    }
+                }
+
+                void reset(arena& a) {
+                    a.top = a.begin;
+                    a.last = nullptr;
+                }
+
+            }
+        }
+    }
+}
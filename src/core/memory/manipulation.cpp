@@ -5,10 +5,45 @@
 // https://opensource.org/licenses/MIT
 
 #define __STDC_WANT_LIB_EXT1__ 1
+#include <atomic>
 #include <cstring>
 
 #include "angie/core/memory/manipulation.hpp"
 #include "angie/core/debug/assert.hpp"
+#include "impl/manipulation_impl.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    namespace manip = memory::impl::manipulation;
+
+    void copy_scalar(void* ANGIE_RESTRICT dst,
+                     const void* ANGIE_RESTRICT src, types::size bytes) {
+        memcpy(dst, src, bytes);
+    }
+
+    void set_scalar(void* dst, types::byte value, types::size bytes) {
+        memset(dst, value, bytes);
+    }
+
+    types::boolean is_equal_scalar(const void* dst, const void* src,
+                                   types::size bytes) {
+        return memcmp(dst, src, bytes) == 0;
+    }
+
+    const manip::kernels g_scalar = {
+        copy_scalar, set_scalar, is_equal_scalar, "scalar"
+    };
+
+    // Kernels in use, the C library ones until select_kernels()
+    std::atomic<const manip::kernels*> g_kernels(&g_scalar);
+
+    inline
+    const manip::kernels* get_kernels() {
+        return g_kernels.load(std::memory_order_relaxed);
+    }
+
+}
 
 namespace angie {
     namespace core {
@@ -23,9 +58,8 @@ namespace angie {
 				angie_assert(dst && src,
 					"Destination and source arrays must be not-null");
 
-                // if fails it returns a error_t != 0, otherwise
-                // we can guarantee the whole buffer has been copied.
-                return memcpy_s(dst, bytes, src, bytes) ? 0 : bytes;
+                get_kernels()->copy(dst, src, bytes);
+                return bytes;
             }
 
             types::size move(void* ANGIE_RESTRICT dst,
@@ -37,14 +71,24 @@ namespace angie {
 				angie_assert(dst && src,
 					"Destination and source arrays must be not-null");
 
-                // if fails it returns a error_t != 0, otherwise
-                // we can guarantee the whole buffer has been copied.
-                return memmove_s(dst, bytes, src, bytes) ? 0 : bytes;
+                // Overlapping buffers still get moved correctly,
+                // although not as fast as the disjoint ones.
+                const auto d = reinterpret_cast<types::uintptr>(dst);
+                const auto s = reinterpret_cast<types::uintptr>(src);
+                if ((d > s ? d - s : s - d) < bytes) {
+                    // if fails it returns a error_t != 0, otherwise
+                    // we can guarantee the whole buffer has been copied.
+                    return memmove_s(dst, bytes, src, bytes) ? 0 : bytes;
+                }
+
+                get_kernels()->copy(dst, src, bytes);
+                return bytes;
             }
 
             types::size set(void* dst, types::byte value, types::size bytes) {
                 angie_assert(dst, "Destination array must be not-null");
-                return memset(dst, value, bytes) ? bytes : 0;
+                get_kernels()->set(dst, value, bytes);
+                return bytes;
             }
 
             types::boolean is_equal(const void* dst, const void*  src,
@@ -52,7 +96,21 @@ namespace angie {
 				angie_assert(dst && src,
 					"Destination and source arrays must be not-null");
 
-                return memcmp(dst, src, bytes) == 0;
+                return get_kernels()->is_equal(dst, src, bytes);
+            }
+
+            const types::char8* select_kernels() {
+                const manip::kernels* k = manip::select();
+                if (!k) {
+                    k = &g_scalar;
+                }
+
+                g_kernels.store(k, std::memory_order_relaxed);
+                return k->name;
+            }
+
+            types::size set_stream_threshold(types::size bytes) {
+                return manip::set_stream_threshold(bytes);
             }
 
         }
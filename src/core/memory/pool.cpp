@@ -0,0 +1,296 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy
+#include <new>
+
+#include "angie/core/memory/pool.hpp"
+#include "angie/core/utils.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::pool::heap;
+
+    static_assert(angie::core::utils::is_power_of_two(
+        ANGIE_MEMORY_POOL_SLAB_SIZE), "Slab size must be a power of two");
+
+    static_assert(memory::pool::max_block_size ==
+        memory::pool::min_block_size << (memory::pool::class_count - 1),
+        "Size classes must cover min to max block size");
+
+    constexpr types::size slab_size = ANGIE_MEMORY_POOL_SLAB_SIZE;
+    constexpr types::size chunk_size =
+        ANGIE_MEMORY_POOL_SLAB_SIZE * ANGIE_MEMORY_POOL_CHUNK_SLABS;
+
+    /**
+     * Header at the beginning of every slab.
+     *
+     * Blocks bigger than the max class size are allocated from the parent
+     * with the same header in front, that's how we can tell them apart.
+     * `next` links chunks when in the first slab of a chunk, or links
+     * large blocks together along with `prev`.
+     */
+    struct slab {
+        heap*           owner;
+        types::size     block_size;
+        slab*           prev;
+        slab*           next;
+    };
+
+    constexpr types::size large_offset =
+        (sizeof(slab) + ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1)
+        & ~types::size(ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1);
+
+    inline
+    slab* slab_of(void* ptr) {
+        return reinterpret_cast<slab*>(
+            reinterpret_cast<types::uintptr>(ptr) & ~(slab_size - 1));
+    }
+
+    inline
+    types::size class_of(types::size n) {
+        types::size idx = 0;
+        types::size block = memory::pool::min_block_size;
+        while (block < n) {
+            block <<= 1;
+            ++idx;
+        }
+
+        return idx;
+    }
+
+    types::byte* next_slab(heap* h) {
+        if (h->slab == h->slab_end) {
+            auto* chunk = static_cast<types::byte*>(memory::alloc(
+                h->parent, chunk_size, slab_size));
+
+            if (!chunk) {
+                return nullptr;
+            }
+
+            reinterpret_cast<slab*>(chunk)->next =
+                static_cast<slab*>(h->chunks);
+            h->chunks = chunk;
+            h->slab = chunk;
+            h->slab_end = chunk + chunk_size;
+        }
+
+        auto* s = h->slab;
+        h->slab += slab_size;
+        return s;
+    }
+
+    void* alloc_large(heap* h, types::size sz, types::size al) {
+        const types::size offset = al > large_offset ? al : large_offset;
+        if (offset >= slab_size || sz > ANGIE_MAX_ALLOCATION_SIZE)
+            return nullptr;
+
+        auto* base = static_cast<slab*>(memory::alloc(
+            h->parent, offset + sz, slab_size));
+
+        if (!base) {
+            return nullptr;
+        }
+
+        base->owner = h;
+        base->block_size = sz;
+        base->prev = nullptr;
+        base->next = static_cast<slab*>(h->large);
+        if (base->next) {
+            base->next->prev = base;
+        }
+
+        h->large = base;
+        return reinterpret_cast<types::byte*>(base) + offset;
+    }
+
+    void free_large(heap* h, slab* s) {
+        if (s->prev) s->prev->next = s->next;
+        else h->large = s->next;
+        if (s->next) s->next->prev = s->prev;
+
+        memory::dealloc(h->parent, s);
+    }
+
+    void pool_free(void* ctx, void* ptr) {
+        if (!ptr) return;
+
+        auto* h = static_cast<heap*>(ctx);
+        auto* s = slab_of(ptr);
+
+        if (s->block_size > memory::pool::max_block_size) {
+            free_large(h, s);
+            return;
+        }
+
+        auto& b = h->bins[class_of(s->block_size)];
+        *static_cast<void**>(ptr) = b.free_list;
+        b.free_list = ptr;
+    }
+
+    void* pool_alloc(void* ctx, types::size sz, types::size al) {
+        auto* h = static_cast<heap*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        // Large blocks are told apart by their size, therefore, even
+        // when alignment is what makes them large, we allocate `n`.
+        const types::size n = sz > al ? sz : al;
+        if (n > memory::pool::max_block_size) {
+            return alloc_large(h, n, al);
+        }
+
+        const types::size idx = class_of(n);
+        auto& b = h->bins[idx];
+
+        if (void* ptr = b.free_list) {
+            b.free_list = *static_cast<void**>(ptr);
+            return ptr;
+        }
+
+        if (b.cursor == b.cursor_end) {
+            auto* s = next_slab(h);
+            if (!s) {
+                return nullptr;
+            }
+
+            const types::size block = memory::pool::min_block_size << idx;
+            auto* header = reinterpret_cast<slab*>(s);
+            header->owner = h;
+            header->block_size = block;
+
+            // Blocks are aligned to their own size, so the first
+            // one starts right after the header, rounded to `block`.
+            b.cursor = s + ((sizeof(slab) + block - 1) & ~(block - 1));
+            b.cursor_end = s + slab_size;
+        }
+
+        void* ptr = b.cursor;
+        b.cursor += memory::pool::min_block_size << idx;
+        return ptr;
+    }
+
+    void pool_free_sized(void* ctx, void* ptr, types::size sz) {
+        if (!ptr) return;
+
+        // Blocks past the max class size can only be large ones,
+        // smaller sizes may be large too, if aligned past it.
+        if (sz > memory::pool::max_block_size) {
+            free_large(static_cast<heap*>(ctx), slab_of(ptr));
+            return;
+        }
+
+        pool_free(ctx, ptr);
+    }
+
+    void* pool_realloc(void* ctx, void* ptr, types::size sz, types::size al) {
+        auto* h = static_cast<heap*>(ctx);
+
+        if (!ptr) return pool_alloc(ctx, sz, al);
+        if (!sz) return pool_free(ctx, ptr), nullptr;
+
+        const types::size osz = memory::pool::size_of(*h, ptr);
+        if (sz <= osz && (!al || angie_is_aligned(ptr, al))) {
+            return ptr;
+        }
+
+        void* nptr = pool_alloc(ctx, sz, al);
+        if (nptr) {
+            memcpy(nptr, ptr, osz < sz ? osz : sz);
+            pool_free(ctx, ptr);
+        }
+
+        return nptr;
+    }
+
+    types::boolean pool_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* h = static_cast<heap*>(ctx);
+        slab* s = slab_of(ptr);
+
+        if (sz <= s->block_size) {
+            return true;
+        }
+
+        // Large blocks have been allocated on their own,
+        // hence, the parent allocator may be able to grow them.
+        if (s->block_size > memory::pool::max_block_size
+            && sz <= ANGIE_MAX_ALLOCATION_SIZE) {
+            const auto offset = static_cast<types::size>(
+                static_cast<types::byte*>(ptr)
+                - reinterpret_cast<types::byte*>(s));
+
+            if (memory::try_expand(h->parent, s, offset + sz)) {
+                s->block_size = sz;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace pool {
+
+                heap* make(const allocator* parent) {
+                    if (!parent)
+                        return nullptr;
+
+                    auto* buffer = memory::alloc(parent, sizeof(heap),
+                        alignof(heap));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    auto* h = new(buffer) heap {
+                        { pool_alloc, pool_free, pool_realloc, buffer,
+                          pool_try_expand, pool_free_sized },
+                        {}, nullptr, nullptr, nullptr, nullptr, parent
+                    };
+
+                    return h;
+                }
+
+                void destroy(heap*& h) {
+                    if (h) {
+                        const allocator* parent = h->parent;
+
+                        auto* large = static_cast<slab*>(h->large);
+                        while (large) {
+                            auto* next = large->next;
+                            memory::dealloc(parent, large);
+                            large = next;
+                        }
+
+                        auto* chunk = static_cast<slab*>(h->chunks);
+                        while (chunk) {
+                            auto* next = chunk->next;
+                            memory::dealloc(parent, chunk);
+                            chunk = next;
+                        }
+
+                        h->~heap();
+                        memory::dealloc(parent, h);
+                        h = nullptr;
+                    }
+                }
+
+                types::size size_of(const heap&, void* ptr) {
+                    return ptr ? slab_of(ptr)->block_size : 0;
+                }
+
+            }
+        }
+    }
+}
@@ -0,0 +1,407 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "angie/core/memory/profiler.hpp"
+
+#ifdef ANGIE_MEMORY_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cmath>   // exp/log
+#include <cstdio>  // snprintf
+#include <new>
+
+#include "dbgtools/callstack.h"
+#include "impl/global_impl.hpp"
+#include "impl/profiler_impl.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace profiler {
+
+                    thread_local types::int64 t_countdown = 0;
+                    std::atomic<types::uint8>
+                        g_filter[types::size(1) << filter_bits];
+
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+    using namespace angie::core;
+
+    constexpr types::size max_depth = ANGIE_MEMORY_PROFILER_DEPTH;
+    constexpr types::size site_count = types::size(1) << 12;
+    constexpr types::size sample_count = types::size(1) << 15;
+
+    // Sampling is re-evaluated every this many bytes, while disabled
+    constexpr types::int64 disabled_interval = types::int64(1) << 26;
+
+    /**
+     * Sampled call site, identified by the hash of its frames.
+     */
+    struct site {
+        types::uint64   hash;
+        types::size     depth;
+        void*           frames[max_depth];
+        types::size     live_bytes;
+        types::size     live_blocks;
+    };
+
+    /**
+     * Sampled block still alive, null `ptr` marks a free entry.
+     */
+    struct entry {
+        void*           ptr;
+        types::size     site;
+        types::size     weight;
+    };
+
+    /**
+     * Open addressing hash tables, for sites and live samples.
+     *
+     * Sites are never removed, live samples are removed by
+     * backward shifting the entries following them.
+     */
+    struct tables {
+        site            sites[site_count];
+        entry           samples[sample_count];
+        types::size     used_sites;
+        types::size     used_samples;
+    };
+
+    std::atomic_flag g_lock = ATOMIC_FLAG_INIT;
+    tables* g_tables = nullptr;
+    bool g_failed = false;
+
+    std::atomic<types::size> g_rate(ANGIE_MEMORY_PROFILER_RATE);
+
+    thread_local types::uint64 t_seed = 0;
+    thread_local bool t_busy = false;
+
+    struct scoped_lock {
+        scoped_lock() {
+            while (g_lock.test_and_set(std::memory_order_acquire)) {}
+        }
+
+        ~scoped_lock() {
+            g_lock.clear(std::memory_order_release);
+        }
+    };
+
+    // Draw the bytes to the next sample, from an exponential
+    // distribution, so that sampling can't lock on to any
+    // periodic allocation pattern.
+    types::int64 next_interval(types::size rate) {
+        if (!t_seed) {
+            t_seed = (reinterpret_cast<types::uintptr>(&t_seed)
+                ^ static_cast<types::uint64>(std::chrono::steady_clock::now()
+                    .time_since_epoch().count())) | 1;
+        }
+
+        t_seed ^= t_seed >> 12;
+        t_seed ^= t_seed << 25;
+        t_seed ^= t_seed >> 27;
+
+        const double u = static_cast<double>(
+            (t_seed * 0x2545F4914F6CDD1Dull) >> 11) / 9007199254740992.0;
+
+        const double bytes = -std::log(1.0 - u) * static_cast<double>(rate);
+        return bytes < 1.0 ? 1 : static_cast<types::int64>(bytes);
+    }
+
+    inline
+    types::size sample_slot(const void* ptr) {
+        const auto key = static_cast<types::uint64>(
+            reinterpret_cast<types::uintptr>(ptr) >> 4);
+        return static_cast<types::size>(
+            (key * 0x9E3779B97F4A7C15ull) >> 40) & (sample_count - 1);
+    }
+
+    // Must be called while holding the lock
+    bool acquire_tables() {
+        if (!g_tables && !g_failed) {
+            void* mem = memory::impl::allocate(sizeof(tables),
+                alignof(tables));
+
+            g_failed = !mem;
+            g_tables = mem ? new(mem) tables() : nullptr;
+        }
+
+        return g_tables != nullptr;
+    }
+
+    // Must be called while holding the lock
+    types::size find_site(void** frames, types::size depth) {
+        // FNV-1a over the return addresses
+        types::uint64 hash = 0xCBF29CE484222325ull;
+        for (types::size i = 0; i < depth; ++i) {
+            hash ^= reinterpret_cast<types::uintptr>(frames[i]);
+            hash *= 0x100000001B3ull;
+        }
+
+        auto& t = *g_tables;
+        for (types::size i = hash & (site_count - 1);;
+             i = (i + 1) & (site_count - 1)) {
+            site& s = t.sites[i];
+
+            if (!s.depth) {
+                // Keep a quarter of the table free, for short probes
+                if (t.used_sites >= site_count - site_count / 4) {
+                    return site_count;
+                }
+
+                s.hash = hash;
+                s.depth = depth;
+                for (types::size f = 0; f < depth; ++f) {
+                    s.frames[f] = frames[f];
+                }
+
+                ++t.used_sites;
+                return i;
+            }
+
+            if (s.hash == hash && s.depth == depth) {
+                return i;
+            }
+        }
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace profiler {
+
+                    void sample(void* ptr, types::size size) {
+                        const types::size rate =
+                            g_rate.load(std::memory_order_relaxed);
+
+                        if (!rate) {
+                            t_countdown = disabled_interval;
+                            return;
+                        }
+
+                        // The first allocation of a thread only arms it
+                        const bool armed = t_seed != 0;
+                        t_countdown = next_interval(rate);
+                        if (!armed || t_busy) {
+                            return;
+                        }
+
+                        auto& slot = g_filter[filter_slot(ptr)];
+                        if (slot.load(std::memory_order_relaxed) == 0xFF) {
+                            return;
+                        }
+
+                        // Each sample stands for all the bytes allocated
+                        // since the previous one, estimated as the size
+                        // of the block over its probability to be sampled.
+                        const double sz = static_cast<double>(size);
+                        const auto weight = static_cast<types::size>(
+                            sz / (1.0 - std::exp(-sz / rate)));
+
+                        void* frames[max_depth];
+                        t_busy = true;
+
+                        // Skip this function and memory::allocate()
+                        const int depth = callstack(2, frames,
+                            static_cast<int>(max_depth));
+
+                        if (depth > 0) {
+                            scoped_lock lock;
+
+                            if (acquire_tables() && g_tables->used_samples
+                                < sample_count - sample_count / 4) {
+
+                                const types::size s = find_site(frames,
+                                    static_cast<types::size>(depth));
+
+                                if (s != site_count) {
+                                    auto& t = *g_tables;
+                                    types::size i = sample_slot(ptr);
+                                    while (t.samples[i].ptr) {
+                                        i = (i + 1) & (sample_count - 1);
+                                    }
+
+                                    t.samples[i] = { ptr, s, weight };
+                                    ++t.used_samples;
+
+                                    t.sites[s].live_bytes += weight;
+                                    ++t.sites[s].live_blocks;
+                                    slot.fetch_add(1,
+                                        std::memory_order_relaxed);
+                                }
+                            }
+                        }
+
+                        t_busy = false;
+                    }
+
+                    void forget(void* ptr) {
+                        scoped_lock lock;
+
+                        if (!g_tables) {
+                            return;
+                        }
+
+                        auto& t = *g_tables;
+                        types::size i = sample_slot(ptr);
+                        while (t.samples[i].ptr != ptr) {
+                            if (!t.samples[i].ptr) {
+                                return;
+                            }
+
+                            i = (i + 1) & (sample_count - 1);
+                        }
+
+                        site& s = t.sites[t.samples[i].site];
+                        s.live_bytes -= t.samples[i].weight;
+                        --s.live_blocks;
+                        --t.used_samples;
+                        g_filter[filter_slot(ptr)].fetch_sub(1,
+                            std::memory_order_relaxed);
+
+                        // Shift back the entries of the same cluster
+                        // which are not at their home slot anymore.
+                        types::size hole = i;
+                        for (types::size j = (i + 1) & (sample_count - 1);
+                             t.samples[j].ptr;
+                             j = (j + 1) & (sample_count - 1)) {
+                            const types::size home =
+                                sample_slot(t.samples[j].ptr);
+
+                            const bool movable = (hole <= j)
+                                ? (home <= hole || home > j)
+                                : (home <= hole && home > j);
+
+                            if (movable) {
+                                t.samples[hole] = t.samples[j];
+                                hole = j;
+                            }
+                        }
+
+                        t.samples[hole].ptr = nullptr;
+                    }
+
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace profiler {
+
+                void set_sample_rate(types::size bytes) {
+#ifdef ANGIE_MEMORY_PROFILER
+                    g_rate.store(bytes, std::memory_order_relaxed);
+
+                    // Pick up the new rate straight away on this thread
+                    impl::profiler::t_countdown = 0;
+#else
+                    (void)bytes;
+#endif
+                }
+
+                types::size get_sample_rate() {
+#ifdef ANGIE_MEMORY_PROFILER
+                    return g_rate.load(std::memory_order_relaxed);
+#else
+                    return 0;
+#endif
+                }
+
+                types::size dump(line_callback* cb, void* user_data) {
+#ifdef ANGIE_MEMORY_PROFILER
+                    if (!cb) {
+                        return 0;
+                    }
+
+                    // Take a copy of the live sites, so that symbols can
+                    // be resolved without holding the lock.
+                    site* sites = nullptr;
+                    types::size count = 0;
+                    {
+                        scoped_lock lock;
+
+                        if (!g_tables || !g_tables->used_sites) {
+                            return 0;
+                        }
+
+                        sites = static_cast<site*>(impl::allocate(
+                            sizeof(site) * g_tables->used_sites,
+                            alignof(site)));
+
+                        if (!sites) {
+                            return 0;
+                        }
+
+                        for (const site& s : g_tables->sites) {
+                            if (s.depth && s.live_blocks) {
+                                sites[count++] = s;
+                            }
+                        }
+                    }
+
+                    callstack_symbol_t symbols[max_depth];
+                    char names[max_depth * 256];
+                    char line[4096];
+
+                    for (types::size i = 0; i < count; ++i) {
+                        const site& s = sites[i];
+                        const int n = callstack_symbols(
+                            const_cast<void**>(s.frames), symbols,
+                            static_cast<int>(s.depth), names,
+                            static_cast<int>(sizeof(names)));
+
+                        // Outermost frame first, as expected by the format
+                        types::size len = 0;
+                        for (int f = static_cast<int>(s.depth) - 1;
+                             f >= 0 && len < sizeof(line); --f) {
+                            const bool known = f < n && symbols[f].function;
+                            const int w = known
+                                ? snprintf(line + len, sizeof(line) - len,
+                                    "%s%s", len ? ";" : "",
+                                    symbols[f].function)
+                                : snprintf(line + len, sizeof(line) - len,
+                                    "%s%p", len ? ";" : "", s.frames[f]);
+
+                            len += w > 0 ? static_cast<types::size>(w) : 0;
+                        }
+
+                        if (len < sizeof(line)) {
+                            snprintf(line + len, sizeof(line) - len, " %llu",
+                                static_cast<unsigned long long>(
+                                    s.live_bytes));
+                        }
+
+                        line[sizeof(line) - 1] = '\0';
+                        cb(line, user_data);
+                    }
+
+                    impl::deallocate(sites);
+                    return count;
+#else
+                    return (void)cb, (void)user_data, 0;
+#endif
+                }
+
+            }
+        }
+    }
+}
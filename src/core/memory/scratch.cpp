@@ -0,0 +1,73 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "angie/core/memory/scratch.hpp"
+
+namespace {
+
+    using namespace angie::core;
+
+    /**
+     * Scratch region of a thread, it is destroyed
+     * along with the other thread-local objects.
+     */
+    struct holder {
+        memory::stack::region*  region;
+        bool                    finalized;
+
+        ~holder() {
+            finalized = true;
+            memory::stack::destroy(region);
+        }
+    };
+
+    thread_local holder t_scratch = { nullptr, false };
+
+    memory::stack::region* get_region() {
+        holder& h = t_scratch;
+
+        // Thread-local destructors already ran for this thread
+        if (!h.region && !h.finalized) {
+            h.region = memory::stack::make(ANGIE_MEMORY_SCRATCH_SIZE);
+        }
+
+        return h.region;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace scratch {
+
+                scope::scope()
+                    : region(get_region()), mark { nullptr, nullptr } {
+                    if (region) {
+                        mark = stack::get_marker(*region);
+                    }
+                }
+
+                scope::~scope() {
+                    if (region) {
+                        stack::free_to_marker(*region, mark);
+                    }
+                }
+
+                const allocator* scope::get_allocator() const {
+                    return region ? stack::get_allocator(*region)
+                        : get_default_allocator();
+                }
+
+                types::size get_free() {
+                    const stack::region* r = t_scratch.region;
+                    return r ? stack::get_free(*r) : 0;
+                }
+
+            }
+        }
+    }
+}
@@ -0,0 +1,284 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy/memmove
+#include <new>
+
+#include "angie/core/memory/stack.hpp"
+#include "angie/core/utils.hpp"
+#include "angie/core/debug/assert.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::stack::region;
+
+    /**
+     * Header preceding every block, it holds the state
+     * of the side before the block has been allocated.
+     */
+    struct header {
+        types::byte*    prev_top;
+        types::byte*    prev_last;
+        types::size     size;
+        types::size     align;
+    };
+
+    inline
+    header* header_of(void* ptr) {
+        return static_cast<header*>(ptr) - 1;
+    }
+
+    inline
+    types::byte* align_forward(types::byte* ptr, types::size al) {
+        return reinterpret_cast<types::byte*>(
+            (reinterpret_cast<types::uintptr>(ptr) + (al - 1)) & ~(al - 1));
+    }
+
+    inline
+    types::byte* align_backward(types::byte* ptr, types::size al) {
+        return reinterpret_cast<types::byte*>(
+            reinterpret_cast<types::uintptr>(ptr) & ~(al - 1));
+    }
+
+    // Place a block growing downward from `top`, return null if it
+    // would cross `limit`, which is the top of the low side.
+    types::byte* place_high(types::byte* top, types::byte* limit,
+                            types::size sz, types::size al) {
+        if (sz > static_cast<types::size>(top - limit))
+            return nullptr;
+
+        types::byte* ptr = align_backward(top - sz, al);
+        if (reinterpret_cast<types::uintptr>(ptr) <
+            reinterpret_cast<types::uintptr>(limit) + sizeof(header))
+            return nullptr;
+
+        return ptr;
+    }
+
+    void* low_alloc(void* ctx, types::size sz, types::size al) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        types::byte* ptr = align_forward(r->low_top + sizeof(header), al);
+
+        // Check against the remaining space rather than computing
+        // `ptr + sz`, which could overflow for huge requests.
+        if (ptr > r->high_top
+            || sz > static_cast<types::size>(r->high_top - ptr))
+            return nullptr;
+
+        *header_of(ptr) = { r->low_top, r->low_last, sz, al };
+        r->low_top = ptr + sz;
+        r->low_last = ptr;
+        return ptr;
+    }
+
+    void low_free(void* ctx, void* ptr) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (ptr && ptr == r->low_last) {
+            const header* h = header_of(ptr);
+            r->low_top = h->prev_top;
+            r->low_last = h->prev_last;
+        }
+    }
+
+    void* low_realloc(void* ctx, void* ptr, types::size sz, types::size al) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (!ptr) return low_alloc(ctx, sz, al);
+        if (!sz) return low_free(ctx, ptr), nullptr;
+
+        auto* bptr = static_cast<types::byte*>(ptr);
+        header* h = header_of(ptr);
+
+        // The last block can grow, or shrink, in place
+        if (bptr == r->low_last && (!al || angie_is_aligned(bptr, al))
+            && sz <= static_cast<types::size>(r->high_top - bptr)) {
+            r->low_top = bptr + sz;
+            h->size = sz;
+            return ptr;
+        }
+
+        // Blocks not on top can still shrink, without giving memory back
+        if (sz <= h->size && (!al || angie_is_aligned(bptr, al))) {
+            return ptr;
+        }
+
+        const types::size osz = h->size;
+        void* nptr = low_alloc(ctx, sz, al ? al : h->align);
+        if (nptr) {
+            memcpy(nptr, ptr, osz < sz ? osz : sz);
+        }
+
+        return nptr;
+    }
+
+    types::boolean low_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* r = static_cast<region*>(ctx);
+        auto* bptr = static_cast<types::byte*>(ptr);
+        header* h = header_of(ptr);
+
+        if (sz <= h->size) {
+            return true;
+        }
+
+        // Only the last block has free space after it
+        if (bptr != r->low_last
+            || sz > static_cast<types::size>(r->high_top - bptr)) {
+            return false;
+        }
+
+        r->low_top = bptr + sz;
+        h->size = sz;
+        return true;
+    }
+
+    void* high_alloc(void* ctx, types::size sz, types::size al) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        types::byte* ptr = place_high(r->high_top, r->low_top, sz, al);
+        if (!ptr) {
+            return nullptr;
+        }
+
+        *header_of(ptr) = { r->high_top, r->high_last, sz, al };
+        r->high_top = reinterpret_cast<types::byte*>(header_of(ptr));
+        r->high_last = ptr;
+        return ptr;
+    }
+
+    void high_free(void* ctx, void* ptr) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (ptr && ptr == r->high_last) {
+            const header* h = header_of(ptr);
+            r->high_top = h->prev_top;
+            r->high_last = h->prev_last;
+        }
+    }
+
+    void* high_realloc(void* ctx, void* ptr, types::size sz,
+                       types::size al) {
+        auto* r = static_cast<region*>(ctx);
+
+        if (!ptr) return high_alloc(ctx, sz, al);
+        if (!sz) return high_free(ctx, ptr), nullptr;
+
+        const header h = *header_of(ptr);
+        if (!al) al = h.align;
+
+        // The last block can only grow downward, hence, it is moved
+        // within its own space plus the free one below it. Source and
+        // destination may overlap, and the move may overwrite the old
+        // header, which is why it has been copied above.
+        if (ptr == r->high_last && utils::is_power_of_two(al)) {
+            if (auto* nptr = place_high(h.prev_top, r->low_top, sz, al)) {
+                memmove(nptr, ptr, h.size < sz ? h.size : sz);
+                *header_of(nptr) = { h.prev_top, h.prev_last, sz, al };
+                r->high_top = reinterpret_cast<types::byte*>(
+                    header_of(nptr));
+                r->high_last = nptr;
+                return nptr;
+            }
+
+            return nullptr;
+        }
+
+        if (sz <= h.size && angie_is_aligned(ptr, al)) {
+            return ptr;
+        }
+
+        void* nptr = high_alloc(ctx, sz, al);
+        if (nptr) {
+            memcpy(nptr, ptr, h.size < sz ? h.size : sz);
+        }
+
+        return nptr;
+    }
+
+    types::boolean high_try_expand(void*, void* ptr, types::size sz) {
+        // Blocks on the high side can only grow downward, by moving
+        return sz <= header_of(ptr)->size;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace stack {
+
+                region* make(types::size capacity, const allocator* parent) {
+                    if (!parent || !capacity)
+                        return nullptr;
+
+                    const types::size offset = (sizeof(region)
+                        + ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1)
+                        & ~types::size(ANGIE_DEFAULT_MEMORY_ALIGNMENT - 1);
+
+                    auto* buffer = static_cast<types::byte*>(memory::alloc(
+                        parent, offset + capacity,
+                        ANGIE_DEFAULT_MEMORY_ALIGNMENT));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    types::byte* begin = buffer + offset;
+                    types::byte* end = begin + capacity;
+                    return new(buffer) region {
+                        { low_alloc, low_free, low_realloc, buffer,
+                          low_try_expand, nullptr },
+                        { high_alloc, high_free, high_realloc, buffer,
+                          high_try_expand, nullptr },
+                        begin, begin, nullptr, end, nullptr, end, parent
+                    };
+                }
+
+                void destroy(region*& r) {
+                    if (r) {
+                        const allocator* parent = r->parent;
+                        r->~region();
+                        memory::dealloc(parent, r);
+                        r = nullptr;
+                    }
+                }
+
+                void free_to_marker(region& r, const marker& m, side from) {
+                    if (from == side::low) {
+                        angie_assert(m.top >= r.begin && m.top <= r.low_top,
+                            "Marker doesn't belong to the low side");
+                        r.low_top = m.top;
+                        r.low_last = m.last;
+                    } else {
+                        angie_assert(m.top <= r.end && m.top >= r.high_top,
+                            "Marker doesn't belong to the high side");
+                        r.high_top = m.top;
+                        r.high_last = m.last;
+                    }
+                }
+
+                void reset(region& r) {
+                    r.low_top = r.begin;
+                    r.low_last = nullptr;
+                    r.high_top = r.end;
+                    r.high_last = nullptr;
+                }
+
+            }
+        }
+    }
+}
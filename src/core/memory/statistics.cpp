@@ -0,0 +1,314 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>  // snprintf
+#include <cstring> // memcpy
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "angie/core/memory/statistics.hpp"
+#include "angie/core/utils.hpp"
+#include "impl/stats_impl.hpp"
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace impl {
+                namespace stats {
+
+                    counters g_global;
+
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+    using namespace angie::core;
+    using memory::stats::tracker;
+    namespace istats = memory::impl::stats;
+
+    /**
+     * Header preceding every tracked block.
+     */
+    struct prefix {
+        types::size     size;
+        types::size     offset;
+    };
+
+    inline
+    prefix* prefix_of(void* ptr) {
+        return static_cast<prefix*>(ptr) - 1;
+    }
+
+    inline
+    types::size offset_of(types::size al) {
+        return al > sizeof(prefix) ? al : sizeof(prefix);
+    }
+
+    void* tracker_alloc(void* ctx, types::size sz, types::size al) {
+        auto* t = static_cast<tracker*>(ctx);
+
+        if (!al) al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+        if (!sz || !utils::is_power_of_two(al))
+            return nullptr;
+
+        const types::size offset = offset_of(al);
+        if (sz > ~types::size(0) - offset)
+            return nullptr;
+
+        auto* base = static_cast<types::byte*>(
+            memory::alloc(t->parent, offset + sz, al));
+
+        if (!base) {
+            return nullptr;
+        }
+
+        void* ptr = base + offset;
+        *prefix_of(ptr) = { sz, offset };
+        istats::on_allocate(t->data, sz, sz);
+        return ptr;
+    }
+
+    void tracker_free(void* ctx, void* ptr) {
+        auto* t = static_cast<tracker*>(ctx);
+
+        if (ptr) {
+            const prefix p = *prefix_of(ptr);
+            istats::on_deallocate(t->data, p.size);
+            memory::dealloc(t->parent, static_cast<types::byte*>(ptr)
+                - p.offset);
+        }
+    }
+
+    void* tracker_realloc(void* ctx, void* ptr, types::size sz,
+                          types::size al) {
+        auto* t = static_cast<tracker*>(ctx);
+
+        if (!ptr) return tracker_alloc(ctx, sz, al);
+        if (!sz) return tracker_free(ctx, ptr), nullptr;
+
+        const prefix p = *prefix_of(ptr);
+        const types::size offset = al ? offset_of(al) : p.offset;
+        if (sz > ~types::size(0) - offset || (al && !utils::is_power_of_two(al)))
+            return nullptr;
+
+        auto* base = static_cast<types::byte*>(ptr) - p.offset;
+        const types::size copy = p.size < sz ? p.size : sz;
+        types::byte* nbase = nullptr;
+
+        // The parent can resize the block only if the header doesn't
+        // need to move, otherwise, the block has to be moved by hand.
+        if (offset == p.offset) {
+            nbase = static_cast<types::byte*>(
+                memory::realloc(t->parent, base, offset + sz, al));
+        } else {
+            nbase = static_cast<types::byte*>(
+                memory::alloc(t->parent, offset + sz, al));
+
+            if (nbase) {
+                memcpy(nbase + offset, ptr, copy);
+                memory::dealloc(t->parent, base);
+            }
+        }
+
+        if (!nbase) {
+            return nullptr;
+        }
+
+        void* nptr = nbase + offset;
+        *prefix_of(nptr) = { sz, offset };
+        istats::on_reallocate(t->data, p.size, sz,
+            nptr != ptr ? copy : 0);
+        return nptr;
+    }
+
+    types::boolean tracker_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* t = static_cast<tracker*>(ctx);
+        prefix* p = prefix_of(ptr);
+
+        if (sz <= p->size) {
+            return true;
+        }
+
+        if (sz > ~types::size(0) - p->offset || !memory::try_expand(
+                t->parent, static_cast<types::byte*>(ptr) - p->offset,
+                p->offset + sz)) {
+            return false;
+        }
+
+        istats::on_reallocate(t->data, p->size, sz, 0);
+        p->size = sz;
+        return true;
+    }
+
+    void copy(const memory::stats::counters& c,
+              memory::stats::snapshot& out) {
+        out.live = c.live.load(std::memory_order_relaxed);
+        out.peak = c.peak.load(std::memory_order_relaxed);
+        out.allocations = c.allocations.load(std::memory_order_relaxed);
+        out.deallocations = c.deallocations.load(std::memory_order_relaxed);
+        out.reallocations = c.reallocations.load(std::memory_order_relaxed);
+        out.copied = c.copied.load(std::memory_order_relaxed);
+
+        for (types::size i = 0; i < memory::stats::histogram_bins; ++i) {
+            out.histogram[i] = c.histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+#ifdef ANGIE_MEMORY_STATISTICS
+    /**
+     * Background thread emitting the global statistics.
+     */
+    struct reporter {
+        std::mutex                  lock;
+        std::condition_variable     wake;
+        std::thread                 worker;
+        bool                        running;
+    };
+
+    reporter& get_reporter() {
+        static reporter r;
+        return r;
+    }
+
+    void report_loop(system::report::callback* cb, types::uint32 period) {
+        auto& r = get_reporter();
+
+        memory::stats::snapshot prev;
+        copy(istats::g_global, prev);
+
+        std::unique_lock<std::mutex> lock(r.lock);
+        while (!r.wake.wait_for(lock, std::chrono::milliseconds(period),
+            [&r] { return !r.running; })) {
+
+            memory::stats::snapshot cur;
+            copy(istats::g_global, cur);
+
+            const auto rate = [period](types::size from, types::size to) {
+                return static_cast<unsigned long long>(
+                    (to - from) * 1000 / period);
+            };
+
+            char msg[256];
+            snprintf(msg, sizeof(msg), "memory: live %llu KB, peak %llu KB, "
+                "%llu allocs/s, %llu frees/s, %llu reallocs/s, "
+                "realloc copied %llu KB/s",
+                static_cast<unsigned long long>(cur.live >> 10),
+                static_cast<unsigned long long>(cur.peak >> 10),
+                rate(prev.allocations, cur.allocations),
+                rate(prev.deallocations, cur.deallocations),
+                rate(prev.reallocations, cur.reallocations),
+                rate(prev.copied, cur.copied) >> 10);
+
+            // Don't hold the lock while reporting, the callback
+            // may take a while, or it could even stop the report.
+            lock.unlock();
+            cb(system::report::level::performance, msg);
+            lock.lock();
+
+            prev = cur;
+        }
+    }
+#endif
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace stats {
+
+                tracker* make(const allocator* parent) {
+                    if (!parent)
+                        return nullptr;
+
+                    void* buffer = memory::alloc(parent,
+                        sizeof(tracker), alignof(tracker));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    return new(buffer) tracker {
+                        { tracker_alloc, tracker_free, tracker_realloc,
+                          buffer, tracker_try_expand, nullptr },
+                        {}, parent
+                    };
+                }
+
+                void destroy(tracker*& t) {
+                    if (t) {
+                        const allocator* parent = t->parent;
+                        t->~tracker();
+                        memory::dealloc(parent, t);
+                        t = nullptr;
+                    }
+                }
+
+                types::boolean query(const allocator* ator, snapshot& out) {
+                    if (!ator) {
+                        return false;
+                    }
+
+                    if (ator->alloc == tracker_alloc) {
+                        copy(static_cast<tracker*>(ator->context)->data, out);
+                        return true;
+                    }
+
+#ifdef ANGIE_MEMORY_STATISTICS
+                    if (ator == get_default_allocator()) {
+                        copy(istats::g_global, out);
+                        return true;
+                    }
+#endif
+
+                    return false;
+                }
+
+                types::boolean start_report(system::report::callback* cb,
+                                            types::uint32 period_ms) {
+#ifdef ANGIE_MEMORY_STATISTICS
+                    auto& r = get_reporter();
+                    std::lock_guard<std::mutex> lock(r.lock);
+
+                    if (!cb || !period_ms || r.running) {
+                        return false;
+                    }
+
+                    r.running = true;
+                    r.worker = std::thread(report_loop, cb, period_ms);
+                    return true;
+#else
+                    return (void)cb, (void)period_ms, false;
+#endif
+                }
+
+                void stop_report() {
+#ifdef ANGIE_MEMORY_STATISTICS
+                    auto& r = get_reporter();
+                    {
+                        std::lock_guard<std::mutex> lock(r.lock);
+                        r.running = false;
+                    }
+
+                    r.wake.notify_all();
+                    if (r.worker.joinable()) {
+                        r.worker.join();
+                    }
+#endif
+                }
+
+            }
+        }
+    }
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>  // snprintf
+#include <mutex>
+#include <thread>
+
+#include "angie/core/memory/trim.hpp"
+#include "angie/core/memory/global.hpp"
+#include "impl/virtual_impl.hpp"
+
+#ifdef ANGIE_MEMORY_STATISTICS
+#include "impl/stats_impl.hpp"
+#endif
+
+namespace {
+
+    using namespace angie::core;
+
+    std::atomic<types::size> g_flushes { 0 };
+
+#ifdef ANGIE_MEMORY_TRIMMER
+    /**
+     * Background thread giving memory back to the system.
+     */
+    struct trimmer {
+        std::mutex                  lock;
+        std::condition_variable     wake;
+        std::thread                 worker;
+        bool                        running;
+    };
+
+    trimmer& get_trimmer() {
+        static trimmer t;
+        return t;
+    }
+
+    /**
+     * Whether memory is worth a flush.
+     *
+     * The process has to be idle, not growing since the previous sample,
+     * otherwise, memory given back would be asked for again straight away.
+     */
+    bool should_trim(types::size rss, types::size prev, types::size target) {
+        if (rss <= target || rss > prev + (prev >> 6)) {
+            return false;
+        }
+
+#ifdef ANGIE_MEMORY_STATISTICS
+        // Most of the resident memory is in use, nothing to give back
+        const types::size live = memory::impl::stats::g_global.live.load(
+            std::memory_order_relaxed);
+        if (rss <= live || rss - live < (rss >> 3)) {
+            return false;
+        }
+#endif
+
+        return true;
+    }
+
+    void trim_loop(system::report::callback* cb, types::size target,
+                   types::uint32 period) {
+        static constexpr types::uint32 max_backoff = 16;
+
+        auto& t = get_trimmer();
+        types::size prev = memory::impl::vm::resident_size();
+        types::uint32 backoff = 1;
+        types::uint32 skip = 0;
+
+        std::unique_lock<std::mutex> lock(t.lock);
+        while (!t.wake.wait_for(lock, std::chrono::milliseconds(period),
+            [&t] { return !t.running; })) {
+
+            const types::size rss = memory::impl::vm::resident_size();
+            if (skip || !should_trim(rss, prev, target)) {
+                skip -= skip ? 1 : 0;
+                prev = rss;
+                continue;
+            }
+
+            // Flushing can take a while, and it doesn't need the lock
+            lock.unlock();
+            memory::flush();
+            g_flushes.fetch_add(1, std::memory_order_relaxed);
+
+            const types::size now = memory::impl::vm::resident_size();
+            const types::size trimmed = now < rss ? rss - now : 0;
+
+            // Little given back, it's likely to be so for a while
+            if (trimmed < (rss >> 6)) {
+                backoff = backoff < max_backoff ? backoff << 1 : max_backoff;
+            } else {
+                backoff = 1;
+            }
+
+            skip = backoff - 1;
+            prev = now;
+
+            if (cb && trimmed) {
+                char msg[128];
+                snprintf(msg, sizeof(msg), "memory: trimmed %llu KB, "
+                    "resident %llu KB",
+                    static_cast<unsigned long long>(trimmed >> 10),
+                    static_cast<unsigned long long>(now >> 10));
+                cb(system::report::level::performance, msg);
+            }
+
+            lock.lock();
+        }
+    }
+#endif
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace trim {
+
+                types::size get_resident_size() {
+                    return impl::vm::resident_size();
+                }
+
+                types::boolean start(system::report::callback* cb,
+                                     types::size target,
+                                     types::uint32 period_ms) {
+#ifdef ANGIE_MEMORY_TRIMMER
+                    auto& t = get_trimmer();
+                    std::lock_guard<std::mutex> lock(t.lock);
+
+                    // Without the resident size, there is nothing to watch
+                    if (!period_ms || t.running || !impl::vm::resident_size()) {
+                        return false;
+                    }
+
+                    t.running = true;
+                    t.worker = std::thread(trim_loop, cb, target, period_ms);
+                    return true;
+#else
+                    return (void)cb, (void)target, (void)period_ms, false;
+#endif
+                }
+
+                void stop() {
+#ifdef ANGIE_MEMORY_TRIMMER
+                    auto& t = get_trimmer();
+                    {
+                        std::lock_guard<std::mutex> lock(t.lock);
+                        t.running = false;
+                    }
+
+                    t.wake.notify_all();
+                    if (t.worker.joinable()) {
+                        t.worker.join();
+                    }
+#endif
+                }
+
+                types::size get_flushes() {
+                    return g_flushes.load(std::memory_order_relaxed);
+                }
+
+            }
+        }
+    }
+}
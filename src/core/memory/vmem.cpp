@@ -0,0 +1,259 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <cstring> // memcpy
+#include <new>
+
+#include "angie/core/memory/vmem.hpp"
+#include "angie/core/utils.hpp"
+#include "impl/virtual_impl.hpp"
+
+namespace {
+
+    using namespace angie::core;
+    using memory::vmem::space;
+    namespace vm = memory::impl::vm;
+
+    /**
+     * Header preceding every block.
+     *
+     * For reserved blocks, `base` is the beginning of the reservation,
+     * and both `reserved` and `committed` are counted from there. Blocks
+     * served by the parent allocator have `reserved` set to 0, and `base`
+     * points to the memory returned by the parent.
+     */
+    struct block {
+        types::byte*    base;
+        types::size     reserved;
+        types::size     committed;
+        types::size     size;
+    };
+
+    inline
+    types::size round_up(types::size v, types::size al) {
+        return (v + (al - 1)) & ~(al - 1);
+    }
+
+    inline
+    block* header_of(const void* ptr) {
+        return reinterpret_cast<block*>(const_cast<types::byte*>(
+            static_cast<const types::byte*>(ptr))) - 1;
+    }
+
+    inline
+    types::byte* place(types::byte* base, types::size al) {
+        return reinterpret_cast<types::byte*>(round_up(
+            reinterpret_cast<types::uintptr>(base + sizeof(block)), al));
+    }
+
+    void* vmem_alloc(void* ctx, types::size sz, types::size al) {
+        auto* s = static_cast<space*>(ctx);
+
+        if (al < ANGIE_DEFAULT_MEMORY_ALIGNMENT)
+            al = ANGIE_DEFAULT_MEMORY_ALIGNMENT;
+
+        // Guard the size computations below against overflow
+        const types::size half = ~types::size(0) >> 1;
+        if (!sz || !utils::is_power_of_two(al) || sz > half || al > half) {
+            return nullptr;
+        }
+
+        const types::size page = vm::page_size();
+        const types::size offset = round_up(sizeof(block), al);
+
+        if (offset + sz < page) {
+            auto* base = static_cast<types::byte*>(
+                memory::alloc(s->parent, offset + sz, al));
+
+            if (!base) {
+                return nullptr;
+            }
+
+            types::byte* ptr = base + offset;
+            *header_of(ptr) = { base, 0, 0, sz };
+            return ptr;
+        }
+
+        // Alignments bigger than a page need room to move the block
+        // forward, since the reservation is only aligned to the page.
+        types::size reserved = sz + offset + (al > page ? al : 0);
+        if (reserved < s->reserve) reserved = s->reserve;
+        reserved = round_up(reserved, page);
+
+        auto* base = static_cast<types::byte*>(vm::reserve(reserved));
+        if (!base) {
+            return nullptr;
+        }
+
+        types::byte* ptr = place(base, al);
+        const types::size committed = round_up(
+            static_cast<types::size>(ptr - base) + sz, page);
+
+        if (!vm::commit(base, committed)) {
+            vm::release(base, reserved);
+            return nullptr;
+        }
+
+        *header_of(ptr) = { base, reserved, committed, sz };
+        return ptr;
+    }
+
+    void vmem_free(void* ctx, void* ptr) {
+        auto* s = static_cast<space*>(ctx);
+
+        if (!ptr) {
+            return;
+        }
+
+        const block* h = header_of(ptr);
+        if (h->reserved) {
+            vm::release(h->base, h->reserved);
+        } else {
+            memory::dealloc(s->parent, h->base);
+        }
+    }
+
+    void* vmem_realloc(void* ctx, void* ptr, types::size sz,
+                       types::size al) {
+        if (!ptr) return vmem_alloc(ctx, sz, al);
+        if (!sz) return vmem_free(ctx, ptr), nullptr;
+
+        block* h = header_of(ptr);
+        auto* bptr = static_cast<types::byte*>(ptr);
+
+        if (!al || angie_is_aligned(bptr, al)) {
+            if (h->reserved) {
+                const types::size end =
+                    static_cast<types::size>(bptr - h->base) + sz;
+
+                // Commit, or decommit, the pages after the block, without
+                // moving it, as long as it fits in the reservation.
+                if (end <= h->reserved) {
+                    const types::size committed =
+                        round_up(end, vm::page_size());
+
+                    if (committed > h->committed) {
+                        if (!vm::commit(h->base + h->committed,
+                                committed - h->committed)) {
+                            return nullptr;
+                        }
+                    } else if (committed < h->committed) {
+                        vm::decommit(h->base + committed,
+                            h->committed - committed);
+                    }
+
+                    h->committed = committed;
+                    h->size = sz;
+                    return ptr;
+                }
+            } else if (sz <= h->size) {
+                h->size = sz;
+                return ptr;
+            }
+        }
+
+        // Keep the alignment of the original block, if none is given,
+        // it can't be smaller than the one requested at allocation time.
+        if (!al) {
+            al = utils::alignment_of(reinterpret_cast<types::uintptr>(ptr));
+            if (al > vm::page_size()) al = vm::page_size();
+        }
+
+        void* nptr = vmem_alloc(ctx, sz, al);
+        if (nptr) {
+            memcpy(nptr, ptr, h->size < sz ? h->size : sz);
+            vmem_free(ctx, ptr);
+        }
+
+        return nptr;
+    }
+
+    types::boolean vmem_try_expand(void* ctx, void* ptr, types::size sz) {
+        auto* s = static_cast<space*>(ctx);
+        block* h = header_of(ptr);
+
+        if (sz <= h->size) {
+            return true;
+        }
+
+        auto* bptr = static_cast<types::byte*>(ptr);
+        const auto offset = static_cast<types::size>(bptr - h->base);
+
+        if (h->reserved) {
+            if (sz > h->reserved - offset) {
+                return false;
+            }
+
+            const types::size committed =
+                round_up(offset + sz, vm::page_size());
+
+            if (committed > h->committed) {
+                if (!vm::commit(h->base + h->committed,
+                        committed - h->committed)) {
+                    return false;
+                }
+
+                h->committed = committed;
+            }
+        } else if (!memory::try_expand(s->parent, h->base, offset + sz)) {
+            return false;
+        }
+
+        h->size = sz;
+        return true;
+    }
+
+}
+
+namespace angie {
+    namespace core {
+        namespace memory {
+            namespace vmem {
+
+                space* make(types::size reserve, const allocator* parent) {
+                    if (!parent || !reserve)
+                        return nullptr;
+
+                    void* buffer = memory::alloc(parent,
+                        sizeof(space), alignof(space));
+
+                    // Memory allocation can fail
+                    if (!buffer) {
+                        return nullptr;
+                    }
+
+                    return new(buffer) space {
+                        { vmem_alloc, vmem_free, vmem_realloc, buffer,
+                          vmem_try_expand, nullptr },
+                        round_up(reserve, vm::page_size()), parent
+                    };
+                }
+
+                void destroy(space*& s) {
+                    if (s) {
+                        const allocator* parent = s->parent;
+                        s->~space();
+                        memory::dealloc(parent, s);
+                        s = nullptr;
+                    }
+                }
+
+                types::size get_page_size() {
+                    return vm::page_size();
+                }
+
+                types::size get_reserved(const void* ptr) {
+                    return ptr ? header_of(ptr)->reserved : 0;
+                }
+
+                types::size get_committed(const void* ptr) {
+                    return ptr ? header_of(ptr)->committed : 0;
+                }
+
+            }
+        }
+    }
+}
@@ -4,18 +4,51 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
+#include <cstdio> // snprintf
+
 #include "angie/core/system/system.hpp"
+#include "angie/core/memory/manipulation.hpp"
+#include "angie/core/memory/trim.hpp"
 #include "impl/system_impl.hpp"
 
+#ifdef ANGIE_MEMORY_STATISTICS
+#include "angie/core/memory/statistics.hpp"
+#endif
+
 namespace angie {
     namespace core {
         namespace system {
 
             error init(report::callback *cb) {
-                return impl::init(cb);
+                const types::char8* kernels = memory::select_kernels();
+                if (cb) {
+                    types::char8 msg[64];
+                    snprintf(msg, sizeof(msg), "memory: %s kernels", kernels);
+                    cb(report::level::info, msg);
+                }
+
+                const error err = impl::init(cb);
+
+#ifdef ANGIE_MEMORY_STATISTICS
+                if (err == error::ok && cb) {
+                    memory::stats::start_report(cb);
+                }
+#endif
+#ifdef ANGIE_MEMORY_TRIMMER
+                if (err == error::ok) {
+                    memory::trim::start(cb);
+                }
+#endif
+                return err;
             }
 
             void shutdown() {
+#ifdef ANGIE_MEMORY_TRIMMER
+                memory::trim::stop();
+#endif
+#ifdef ANGIE_MEMORY_STATISTICS
+                memory::stats::stop_report();
+#endif
                 impl::shutdown();
             }
 
@@ -4,10 +4,66 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
+#include <memory>
+#include <string>
+
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
 #include "angie/core/containers/dynamic_array.hpp"
+#include "angie/core/containers/small_array.hpp"
+#include "angie/core/containers/soa_array.hpp"
+#include "angie/core/memory/linear.hpp"
+
+namespace {
+
+	// Counts the live objects, and keeps a pointer to itself,
+	// so that it breaks if moved around as raw memory.
+	struct tracked {
+		static int live;
+
+		tracked() : self(this), value(-1) { ++live; }
+		tracked(int v) : self(this), value(v) { ++live; }
+		tracked(const tracked& o) : self(this), value(o.value) { ++live; }
+		tracked(tracked&& o) : self(this), value(o.value) {
+			o.value = -1;
+			++live;
+		}
+		~tracked() { --live; }
+
+		tracked& operator=(const tracked& o) {
+			value = o.value;
+			return *this;
+		}
+
+		tracked& operator=(tracked&& o) {
+			value = o.value;
+			o.value = -1;
+			return *this;
+		}
+
+		bool intact() const { return self == this; }
+
+		const tracked*	self;
+		int				value;
+	};
+
+	int tracked::live = 0;
+
+}
+
+namespace angie {
+	namespace core {
+		namespace array {
+
+			// Owning a heap pointer, it doesn't care about its address
+			template <>
+			struct is_trivially_relocatable<std::unique_ptr<int>>
+				: std::true_type {};
+
+		}
+	}
+}
 
 TEST_CASE("Dynamic array tests", "[dynamic_array]")
 {
@@ -217,6 +273,64 @@ TEST_CASE("Dynamic array tests", "[dynamic_array]")
 		array::release(u32_a);
 	}
 
+	SECTION("Compact elements") {
+		array::dynamic<types::uint32> u32_a = { 0 };
+		REQUIRE(array::init(u32_a));
+
+		for (types::uint32 i = 0; i < 100000; ++i) {
+			REQUIRE(array::push(u32_a, i));
+		}
+
+		// Cull every third element, as well as a long run
+		auto removed = array::remove_if(u32_a, [](types::uint32 v) {
+			return v % 3 == 0 || (v >= 50000 && v < 60000);
+		});
+
+		REQUIRE(removed == 100000 - u32_a.count);
+		REQUIRE(u32_a.count == 59999);
+		REQUIRE(u32_a.data[0] == 1u);
+		REQUIRE(u32_a.data[1] == 2u);
+		REQUIRE(u32_a.data[2] == 4u);
+
+		bool ordered = true;
+		for (types::size i = 1; i < u32_a.count; ++i) {
+			ordered &= u32_a.data[i - 1] < u32_a.data[i]
+				&& u32_a.data[i] % 3 != 0;
+		}
+		REQUIRE(ordered);
+		REQUIRE(array::remove_if(u32_a, [](types::uint32) {
+			return false;
+		}) == 0);
+
+		// [1,2,4,5,7,8] -> [2,5,8]
+		const types::size indices[] = { 0, 0, 2, 4, 1000000 };
+		REQUIRE(array::resize(u32_a, 6));
+		REQUIRE(array::remove_indices(u32_a, indices, 5) == 3);
+		REQUIRE(u32_a.count == 3);
+		REQUIRE(u32_a.data[0] == 2u);
+		REQUIRE(u32_a.data[1] == 5u);
+		REQUIRE(u32_a.data[2] == 8u);
+
+		array::release(u32_a);
+
+		// [a,a,b,c,c,c,a] -> [a,b,c,a]
+		array::dynamic<types::char8> str_a = { 0 };
+		REQUIRE(array::init(str_a));
+		REQUIRE(array::push_n(str_a, "aabccca", 7));
+		REQUIRE(array::unique(str_a) == 3);
+		REQUIRE(memory::is_equal(str_a.data, "abca", 4));
+		REQUIRE(str_a.count == 4);
+
+		// Case insensitive comparison
+		REQUIRE(array::push_n(str_a, "AbBB", 4));
+		REQUIRE(array::unique(str_a, [](types::char8 l, types::char8 r) {
+			return (l | 0x20) == (r | 0x20);
+		}) == 3);
+		REQUIRE(memory::is_equal(str_a.data, "abcab", 5));
+
+		array::release(str_a);
+	}
+
 	SECTION("Loose/Replace elements") {
 		array::dynamic<types::uint8> u8_a = { 0 };
 		u8_a.ator = memory::get_default_allocator();
@@ -353,6 +467,7 @@ TEST_CASE("Dynamic array tests", "[dynamic_array]")
 		for (auto i = 0u; i < count; ++i) {
 			types::char8 c;
 			REQUIRE(array::pop(*str_a, c));
+			REQUIRE(c == "Lore Ipsum"[count - 1 - i]);
 		}
 
 		REQUIRE(array::is_empty(*str_a));
@@ -363,4 +478,358 @@ TEST_CASE("Dynamic array tests", "[dynamic_array]")
 
 		array::destroy(str_a);
 	}
+
+	SECTION("Bulk push and append") {
+		array::dynamic<types::uint32> u32_a = { 0 };
+		REQUIRE(array::init(u32_a));
+
+		const types::uint32 ids[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		REQUIRE(array::push_n(u32_a, ids, 10));
+		REQUIRE(u32_a.count == 10);
+		REQUIRE(u32_a.capacity == 16);
+
+		auto* data = u32_a.data;
+		REQUIRE(array::append_range(u32_a, ids + 2, ids + 5));
+		REQUIRE(u32_a.count == 13);
+		REQUIRE(u32_a.data == data);
+		REQUIRE(u32_a.data[12] == 4u);
+		REQUIRE(array::push_n(u32_a, ids, 0));
+
+		REQUIRE(array::reserve(u32_a, 3));
+		array::emplace_back_unchecked(u32_a) = 42;
+		array::emplace_back_unchecked(u32_a) = 43;
+		REQUIRE(u32_a.count == 15);
+		REQUIRE(u32_a.data[14] == 43u);
+
+		// Only the requested range of the source is appended
+		array::dynamic<types::uint32> tail_a = { 0 };
+		REQUIRE(array::init(tail_a));
+		REQUIRE(array::append(tail_a, u32_a, 13, 1));
+		REQUIRE(tail_a.count == 1);
+		REQUIRE(tail_a.data[0] == 42u);
+
+		array::release(tail_a);
+		array::release(u32_a);
+	}
+
+	SECTION("Compile-time allocator policy") {
+		using global_array = array::dynamic<types::uint32,
+			array::global_allocator>;
+
+		auto* ids = array::make<types::uint32, array::global_allocator>(4);
+		REQUIRE(ids != nullptr);
+		REQUIRE(array::get_capacity(*ids) >= 4);
+
+		for (types::uint32 i = 0; i < 1000; ++i) {
+			REQUIRE(array::push(*ids, i));
+		}
+
+		REQUIRE(array::get_count(*ids) == 1000);
+		REQUIRE(ids->data[999] == 999);
+
+		// Arrays of different policies still interoperate
+		array::dynamic<types::uint32> copy_a = { 0 };
+		REQUIRE(array::copy(copy_a, *ids, 10, 5));
+		REQUIRE(copy_a.data[0] == 10);
+
+		global_array back_a = { 0 };
+		REQUIRE(array::init(back_a, 2));
+		REQUIRE(array::append(back_a, copy_a));
+		REQUIRE(array::get_count(back_a) == 5);
+		REQUIRE(back_a.data[4] == 14);
+
+		REQUIRE(array::fit(*ids));
+		array::release(back_a);
+		array::release(copy_a);
+		array::destroy(ids);
+		REQUIRE(ids == nullptr);
+	}
+
+	SECTION("Growth policies") {
+		array::dynamic<types::uint32> exact_a = { 0 };
+		array::set_growth(exact_a, array::growth::exact);
+		REQUIRE(array::init(exact_a, 5));
+		REQUIRE(exact_a.capacity == 5);
+		REQUIRE(array::resize(exact_a, 6));
+		REQUIRE(exact_a.capacity == 6);
+
+		// Shrinking honours the capacity, only fit() gives memory back
+		REQUIRE(array::resize(exact_a, 2));
+		REQUIRE(exact_a.capacity == 6);
+		REQUIRE(array::fit(exact_a));
+		REQUIRE(exact_a.capacity == 2);
+
+		auto* chunk_a = array::make<types::uint32>(10,
+			memory::get_default_allocator(), array::growth::chunked, 64);
+		REQUIRE(chunk_a->capacity == 64);
+		REQUIRE(array::resize(*chunk_a, 65));
+		REQUIRE(chunk_a->capacity == 128);
+
+		auto* geo_a = array::make_copy(*chunk_a);
+		REQUIRE(geo_a->grow == array::growth::chunked);
+		array::set_growth(*geo_a, array::growth::geometric);
+		REQUIRE(array::reserve(*geo_a, 64));
+		REQUIRE(geo_a->capacity == 192);
+
+		types::size reallocs = 0;
+		for (types::uint32 i = 0; i < 10000; ++i) {
+			auto capacity = geo_a->capacity;
+			REQUIRE(array::push(*geo_a, i));
+			reallocs += capacity != geo_a->capacity;
+		}
+
+		REQUIRE(geo_a->capacity < 2 * geo_a->count);
+		REQUIRE(reallocs < 20);
+
+		array::destroy(geo_a);
+		array::destroy(chunk_a);
+		array::release(exact_a);
+	}
+
+	struct vertex { float x, y, z; };
+
+	SECTION("Over-aligned storage") {
+		REQUIRE(array::get_align<vertex>() == alignof(vertex));
+		REQUIRE(array::get_align<types::uint64>() == alignof(types::uint64));
+
+		auto* verts = array::make<vertex>(3, memory::get_default_allocator(),
+			array::growth::power_of_two, 0, array::simd_align);
+		REQUIRE(verts != nullptr);
+		REQUIRE(array::get_align(*verts) == array::simd_align);
+		REQUIRE(utils::is_multiple_of((types::uintptr)verts->data,
+			array::simd_align));
+
+		// Growth keeps the alignment, as well as copies do
+		for (types::uint32 i = 0; i < 100; ++i) {
+			REQUIRE(array::push(*verts, vertex{ 1.f * i, 0.f, 0.f }));
+			REQUIRE(array::is_valid(*verts));
+		}
+
+		auto* copy_a = array::make_copy(*verts);
+		REQUIRE(utils::is_multiple_of((types::uintptr)copy_a->data,
+			array::simd_align));
+
+		REQUIRE(array::set_alignment(*copy_a, array::cache_line_align));
+		REQUIRE(utils::is_multiple_of((types::uintptr)copy_a->data,
+			array::cache_line_align));
+		REQUIRE(copy_a->count == 100);
+		REQUIRE(copy_a->data[99].x == 99.f);
+
+		array::destroy(copy_a);
+		array::destroy(verts);
+	}
+
+	SECTION("Non-trivial elements") {
+		{
+			array::dynamic<tracked> objs = { 0 };
+			REQUIRE(array::init(objs));
+
+			for (int i = 0; i < 100; ++i) {
+				REQUIRE(array::push(objs, tracked(i)));
+			}
+
+			REQUIRE(tracked::live == 100);
+
+			bool intact = true;
+			for (types::size i = 0; i < objs.count; ++i) {
+				intact &= objs.data[i].intact()
+					&& objs.data[i].value == int(i);
+			}
+			REQUIRE(intact);
+
+			// Odd values are culled, and destroyed
+			REQUIRE(array::remove_if(objs, [](const tracked& t) {
+				return t.value % 2 != 0;
+			}) == 50);
+			REQUIRE(tracked::live == 50);
+			REQUIRE(objs.data[49].value == 98);
+
+			array::dynamic<tracked> more = { 0 };
+			REQUIRE(array::copy(more, objs, 0, 3));
+			REQUIRE(array::insert(objs, 1, more));
+			REQUIRE(objs.count == 53);
+			REQUIRE(objs.data[1].value == 0);
+			REQUIRE(objs.data[3].value == 4);
+			REQUIRE(objs.data[4].value == 2);
+			REQUIRE(tracked::live == 56);
+
+			tracked last;
+			REQUIRE(array::pop(objs, last));
+			REQUIRE(last.value == 98);
+			REQUIRE(array::remove(objs, 0, 10));
+			REQUIRE(array::resize(objs, 20));
+			REQUIRE(array::fit(objs));
+			REQUIRE(objs.data[0].intact());
+			REQUIRE(tracked::live == 20 + 3 + 1);
+
+			array::release(more);
+			array::release(objs);
+			REQUIRE(tracked::live == 1);
+		}
+		REQUIRE(tracked::live == 0);
+
+		auto* names = array::make<std::string>();
+		REQUIRE(array::push(*names, std::string(64, 'a')));
+		array::emplace_back_unchecked(*names) = "b";
+		REQUIRE(array::reserve(*names, 1));
+		array::emplace_back_unchecked(*names, 3, 'c');
+		REQUIRE(names->data[2] == "ccc");
+		REQUIRE(array::set_alignment(*names, array::cache_line_align));
+		REQUIRE(names->data[0] == std::string(64, 'a'));
+		array::destroy(names);
+
+		// Trivially relocatable, though not copyable, grown through realloc
+		array::dynamic<std::unique_ptr<int>> ptrs = { 0 };
+		REQUIRE(array::init(ptrs));
+		for (int i = 0; i < 1000; ++i) {
+			REQUIRE(array::push(ptrs, std::unique_ptr<int>(new int(i))));
+		}
+
+		REQUIRE(*ptrs.data[999] == 999);
+		REQUIRE(array::remove(ptrs, 0, 500));
+		REQUIRE(*ptrs.data[0] == 500);
+		array::release(ptrs);
+	}
+
+	SECTION("Small arrays") {
+		array::small<types::uint32, 8> ids;
+		REQUIRE(array::is_valid(ids));
+		REQUIRE(array::is_inline(ids));
+		REQUIRE(array::get_capacity(ids) == 8);
+
+		for (types::uint32 i = 0; i < 8; ++i) {
+			REQUIRE(array::push(ids, i));
+		}
+
+		// In place up to the inline capacity...
+		REQUIRE(array::is_inline(ids));
+		REQUIRE(array::is_full(ids));
+
+		// ...and spilled to the allocator beyond it
+		REQUIRE(array::push(ids, 8u));
+		REQUIRE_FALSE(array::is_inline(ids));
+		REQUIRE(ids.capacity >= 9);
+		REQUIRE(ids.data[0] == 0u);
+		REQUIRE(ids.data[8] == 8u);
+
+		REQUIRE(array::remove(ids, 0, 4));
+		REQUIRE(array::fit(ids));
+		REQUIRE(array::is_inline(ids));
+		REQUIRE(ids.count == 5);
+		REQUIRE(ids.data[0] == 4u);
+
+		array::small<types::uint32, 8> other;
+		REQUIRE(array::copy(other, ids));
+		REQUIRE(array::is_inline(other));
+		REQUIRE(array::equal(other, ids));
+
+		array::release(ids);
+		REQUIRE(array::is_inline(ids));
+		REQUIRE(array::is_empty(ids));
+		array::release(other);
+
+		array::small<std::string, 2> names;
+		REQUIRE(array::push(names, std::string("a")));
+		REQUIRE(array::push(names, std::string(64, 'b')));
+		REQUIRE(array::push(names, std::string("c")));
+		REQUIRE_FALSE(array::is_inline(names));
+		std::string last;
+		REQUIRE(array::pop(names, last));
+		REQUIRE(last == "c");
+		REQUIRE(array::fit(names));
+		REQUIRE(array::is_inline(names));
+		REQUIRE(names.data[0] == "a");
+		REQUIRE(names.data[1] == std::string(64, 'b'));
+		array::release(names);
+
+		// Spilled elements are cleaned up on scope exit
+		tracked::live = 0;
+		{
+			array::small<tracked, 2> objects;
+			for (int i = 0; i < 5; ++i) {
+				REQUIRE(array::push(objects, tracked(i)));
+			}
+
+			REQUIRE_FALSE(array::is_inline(objects));
+			REQUIRE(tracked::live == 5);
+		}
+		REQUIRE(tracked::live == 0);
+	}
+
+	SECTION("Structure of arrays") {
+		array::soa<float, types::uint8, types::uint64> particles = { 0 };
+		REQUIRE(array::init(particles, 3));
+		REQUIRE(array::get_capacity(particles) == 4);
+
+		for (types::uint32 i = 0; i < 100; ++i) {
+			REQUIRE(array::push(particles, i, i, types::uint64(i) << 32));
+		}
+
+		// Every column is aligned, and in the same block
+		REQUIRE(array::get_count(particles) == 100);
+		REQUIRE(array::get_capacity(particles) == 128);
+		auto* x = array::get_column<0>(particles);
+		auto* id = array::get_column<1>(particles);
+		auto* key = array::get_column<2>(particles);
+		REQUIRE(utils::is_multiple_of((types::uintptr)x, array::simd_align));
+		REQUIRE(utils::is_multiple_of((types::uintptr)id, array::simd_align));
+		REQUIRE(utils::is_multiple_of((types::uintptr)key, array::simd_align));
+		REQUIRE((types::byte*)id >= (types::byte*)(x + 128));
+		REQUIRE((types::byte*)key >= id + 128);
+
+		float sum = 0;
+		for (types::size i = 0; i < array::get_count(particles); ++i) {
+			x[i] *= 2;
+			sum += x[i];
+		}
+		REQUIRE(sum == 9900);
+		REQUIRE(id[99] == 99);
+		REQUIRE(key[99] == types::uint64(99) << 32);
+
+		// The last elements fill the gap, field by field
+		REQUIRE(array::replace_with_last(particles, 10, 2));
+		REQUIRE(array::get_count(particles) == 98);
+		REQUIRE(x[10] == 196);
+		REQUIRE(id[11] == 99);
+		REQUIRE(key[10] == types::uint64(98) << 32);
+
+		REQUIRE(array::resize(particles, 20));
+		REQUIRE(array::fit(particles));
+		REQUIRE(array::get_capacity(particles) == 32);
+		x = array::get_column<0>(particles);
+		REQUIRE(x[10] == 196);
+		REQUIRE(array::get_column<1>(particles)[19] == 19);
+
+		array::release(particles);
+		REQUIRE(array::is_empty(particles));
+		REQUIRE(particles.columns[0] == nullptr);
+
+		auto* wide = array::make_soa<types::uint32, types::uint16>(10,
+			memory::get_default_allocator(), array::growth::exact, 0,
+			array::cache_line_align);
+		REQUIRE(wide);
+		REQUIRE(array::get_capacity(*wide) == 10);
+		REQUIRE(utils::is_multiple_of((types::uintptr)
+			array::get_column<1>(*wide), array::cache_line_align));
+		REQUIRE(array::push(*wide, 1, 2));
+		array::destroy(wide);
+		REQUIRE(wide == nullptr);
+
+		// The block is given back with the size it was made with, an
+		// arena reclaims its top block only if the size matches.
+		auto* arena = memory::linear::make(64 << 10);
+		auto* ator = memory::linear::get_allocator(*arena);
+		array::soa<float, types::uint8> ids = { 0 };
+		REQUIRE(array::init(ids, 100, ator));
+		REQUIRE(array::push(ids, 1, 2));
+
+		const auto used = memory::linear::get_used(*arena);
+		memory::dealloc(ator, memory::alloc(ator, 8, 1), 8);
+		REQUIRE(memory::linear::get_used(*arena) == used);
+
+		ids.align = 1024;
+		array::release(ids);
+		REQUIRE(memory::linear::get_used(*arena) < used);
+		memory::linear::destroy(arena);
+	}
 }
@@ -0,0 +1,214 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <string>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "angie/core/containers/hash_map.hpp"
+
+namespace {
+
+	// Sends every key to the same group, so that groups fill up
+	struct clash {
+		angie::core::types::size operator()(int) const { return 0; }
+	};
+
+}
+
+TEST_CASE("Flat hash map tests", "[hash_map]")
+{
+	using namespace angie::core;
+
+	SECTION("Create map on the heap") {
+		auto* m = map::make<types::uint32, types::uint32>(100);
+		REQUIRE(m);
+		REQUIRE(map::is_empty(*m));
+		REQUIRE(map::get_capacity(*m) == 128);
+		REQUIRE(m->growth_left == 112);
+
+		map::destroy(m);
+		REQUIRE(m == nullptr);
+	}
+
+	SECTION("Init/Release map") {
+		map::flat<types::uint32, types::uint32> m = { 0 };
+		REQUIRE(map::init(m));
+		REQUIRE(map::get_capacity(m) == 0);
+		REQUIRE(map::find(m, 1u) == nullptr);
+		REQUIRE_FALSE(map::erase(m, 1u));
+
+		REQUIRE(map::insert(m, 1u, 10u));
+		REQUIRE(map::get_capacity(m) == map::group_width);
+
+		map::release(m);
+		REQUIRE(map::is_empty(m));
+		REQUIRE(m.ctrl == nullptr);
+		REQUIRE(m.ator);
+	}
+
+	SECTION("Insert and find") {
+		map::flat<types::uint32, types::uint32> m = { 0 };
+		REQUIRE(map::init(m));
+
+		const types::uint32 num = 100000;
+		for (types::uint32 i = 0; i < num; ++i) {
+			REQUIRE(map::insert(m, i * 7, i));
+		}
+
+		REQUIRE(map::get_count(m) == num);
+		REQUIRE(map::get_count(m) <= map::compute_growth(m.capacity));
+
+		for (types::uint32 i = 0; i < num; ++i) {
+			const auto* v = map::find(m, i * 7);
+			REQUIRE(v);
+			REQUIRE(*v == i);
+			REQUIRE_FALSE(map::contains(m, i * 7 + 1));
+		}
+
+		// Overwrite
+		REQUIRE(*map::insert(m, 7u, 42u) == 42);
+		REQUIRE(map::get_count(m) == num);
+
+		// Add once only
+		*map::find_or_add(m, 3u) += 5;
+		*map::find_or_add(m, 3u) += 5;
+		REQUIRE(*map::find(m, 3u) == 10);
+		REQUIRE(map::get_count(m) == num + 1);
+
+		types::size visited = 0;
+		types::uint64 sum = 0;
+		map::for_each(m, [&](const types::uint32& k, types::uint32& v) {
+			++visited;
+			sum += k == 3 ? 0 : v;
+		});
+		REQUIRE(visited == num + 1);
+		REQUIRE(sum == types::uint64(num) * (num - 1) / 2 - 1 + 42);
+
+		map::clear(m);
+		REQUIRE(map::is_empty(m));
+		REQUIRE(map::find(m, 7u) == nullptr);
+
+		map::release(m);
+	}
+
+	SECTION("Erase without tombstones") {
+		map::flat<types::uint32, types::uint32> m = { 0 };
+		REQUIRE(map::init(m, 1000));
+		const auto capacity = map::get_capacity(m);
+
+		for (types::uint32 i = 0; i < 800; ++i) {
+			REQUIRE(map::insert(m, i, i));
+		}
+
+		// Groups had room left, slots are empty again
+		for (types::uint32 i = 0; i < 800; ++i) {
+			REQUIRE(map::erase(m, i));
+		}
+
+		REQUIRE(map::is_empty(m));
+		REQUIRE(m.growth_left == map::compute_growth(capacity));
+
+		// Churning doesn't grow the table
+		for (types::uint32 round = 1; round < 200; ++round) {
+			for (types::uint32 i = 0; i < 800; ++i) {
+				REQUIRE(map::insert(m, round * 1000 + i, i));
+			}
+
+			for (types::uint32 i = 0; i < 800; ++i) {
+				REQUIRE(map::erase(m, round * 1000 + i));
+			}
+		}
+
+		REQUIRE(map::is_empty(m));
+		REQUIRE(map::get_capacity(m) == capacity);
+
+		// Tombstones left at steady high load are dropped by rehashing
+		for (types::uint32 i = 0; i < 1400; ++i) {
+			REQUIRE(map::insert(m, i, i));
+		}
+
+		for (types::uint32 i = 1400; i < 100000; ++i) {
+			REQUIRE(map::erase(m, i - 1400));
+			REQUIRE(map::insert(m, i, i));
+		}
+
+		REQUIRE(map::get_count(m) == 1400);
+		REQUIRE(map::get_capacity(m) == capacity);
+		for (types::uint32 i = 100000 - 1400; i < 100000; ++i) {
+			REQUIRE(*map::find(m, i) == i);
+		}
+
+		map::release(m);
+	}
+
+	SECTION("Erase from full groups") {
+		map::flat<int, int, clash> m = { 0 };
+		REQUIRE(map::init(m, 100));
+		const auto capacity = map::get_capacity(m);
+
+		for (int i = 0; i < 100; ++i) {
+			REQUIRE(map::insert(m, i, -i));
+		}
+
+		// Probes went through the first groups, they keep tombstones
+		REQUIRE(map::erase(m, 0));
+		REQUIRE_FALSE(map::erase(m, 0));
+		REQUIRE(m.growth_left == map::compute_growth(capacity) - 100);
+
+		for (int i = 1; i < 100; ++i) {
+			REQUIRE(map::find(m, i));
+			REQUIRE(*map::find(m, i) == -i);
+		}
+
+		// Tombstones are reused
+		REQUIRE(map::insert(m, 1000, 1));
+		REQUIRE(m.growth_left == map::compute_growth(capacity) - 100);
+
+		for (int i = 1; i < 50; ++i) {
+			REQUIRE(map::erase(m, i));
+		}
+
+		for (int i = 1; i < 50; ++i) {
+			REQUIRE(map::insert(m, 2000 + i, i));
+		}
+
+		REQUIRE(m.growth_left == map::compute_growth(capacity) - 100);
+		REQUIRE(map::get_count(m) == 100);
+		REQUIRE(map::get_capacity(m) == capacity);
+		REQUIRE(*map::find(m, 1000) == 1);
+
+		map::release(m);
+	}
+
+	SECTION("Non-trivial keys and values") {
+		auto* m = map::make<std::string, std::string>();
+		REQUIRE(m);
+
+		for (int i = 0; i < 1000; ++i) {
+			const auto key = "key-of-a-long-string-" + std::to_string(i);
+			REQUIRE(map::insert(*m, key, std::to_string(i)));
+		}
+
+		for (int i = 0; i < 1000; i += 2) {
+			REQUIRE(map::erase(*m, "key-of-a-long-string-"
+				+ std::to_string(i)));
+		}
+
+		REQUIRE(map::get_count(*m) == 500);
+		for (int i = 0; i < 1000; ++i) {
+			const auto* v = map::find(*m, "key-of-a-long-string-"
+				+ std::to_string(i));
+			REQUIRE((v != nullptr) == (i % 2 == 1));
+			if (v) {
+				REQUIRE(*v == std::to_string(i));
+			}
+		}
+
+		map::destroy(m);
+	}
+}
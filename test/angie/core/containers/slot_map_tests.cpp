@@ -0,0 +1,144 @@
+// Copyright (c) 2017 Fabio Polimeni
+// Created on: 17/10/2026
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <string>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "angie/core/containers/slot_map.hpp"
+
+TEST_CASE("Slot map tests", "[slot_map]")
+{
+	using namespace angie::core;
+
+	SECTION("Create map on the heap") {
+		auto* m = slot::make<types::uint64>(10);
+		REQUIRE(m);
+		REQUIRE(slot::is_empty(*m));
+		REQUIRE(m->data.capacity >= 10);
+		REQUIRE(m->slots.capacity >= 10);
+
+		slot::destroy(m);
+		REQUIRE(m == nullptr);
+	}
+
+	SECTION("Handle size") {
+		REQUIRE(sizeof(slot::handle<types::uint16>) == 4);
+		REQUIRE(sizeof(slot::handle<>) == 8);
+	}
+
+	SECTION("Insert and get") {
+		slot::map<types::uint32> m = { 0 };
+		REQUIRE(slot::init(m));
+
+		slot::handle<> handles[100];
+		for (types::uint32 i = 0; i < 100; ++i) {
+			handles[i] = slot::insert(m, i * 3);
+			REQUIRE(slot::contains(m, handles[i]));
+		}
+
+		REQUIRE(slot::get_count(m) == 100);
+		for (types::uint32 i = 0; i < 100; ++i) {
+			REQUIRE(*slot::get(m, handles[i]) == i * 3);
+			REQUIRE(slot::get_data(m)[i] == i * 3);
+			REQUIRE(slot::get_handle(m, i).index == handles[i].index);
+		}
+
+		REQUIRE_FALSE(slot::contains(m, slot::null_handle()));
+		REQUIRE(slot::get(m, slot::null_handle()) == nullptr);
+
+		slot::release(m);
+	}
+
+	SECTION("Erase keeps data packed") {
+		slot::map<types::uint32> m = { 0 };
+		REQUIRE(slot::init(m, 8));
+
+		slot::handle<> handles[8];
+		for (types::uint32 i = 0; i < 8; ++i) {
+			handles[i] = slot::insert(m, i);
+		}
+
+		// Last element takes the place of the erased one
+		REQUIRE(slot::erase(m, handles[2]));
+		REQUIRE_FALSE(slot::erase(m, handles[2]));
+		REQUIRE(slot::get_count(m) == 7);
+		REQUIRE(slot::get_data(m)[2] == 7);
+		REQUIRE(slot::get(m, handles[7]) == slot::get_data(m) + 2);
+
+		REQUIRE(slot::erase(m, handles[7]));
+		REQUIRE(slot::erase(m, handles[6]));
+		REQUIRE(slot::get_count(m) == 5);
+
+		types::uint32 sum = 0;
+		for (types::size i = 0; i < slot::get_count(m); ++i) {
+			sum += slot::get_data(m)[i];
+		}
+		REQUIRE(sum == 0 + 1 + 3 + 4 + 5);
+
+		for (auto i : { 0, 1, 3, 4, 5 }) {
+			REQUIRE(*slot::get(m, handles[i]) == types::uint32(i));
+		}
+
+		// Slots are reused, stale handles are not
+		auto h = slot::insert(m, 42u);
+		REQUIRE(h.index == handles[6].index);
+		REQUIRE(h.generation != handles[6].generation);
+		REQUIRE(slot::get(m, handles[6]) == nullptr);
+		REQUIRE(*slot::get(m, h) == 42);
+		REQUIRE(slot::get_count(m) == 6);
+		REQUIRE(m.slots.count == 8);
+
+		slot::clear(m);
+		REQUIRE(slot::is_empty(m));
+		REQUIRE_FALSE(slot::contains(m, h));
+		REQUIRE_FALSE(slot::contains(m, handles[0]));
+
+		slot::release(m);
+	}
+
+	SECTION("Churn with small handles") {
+		slot::map<types::uint64, types::uint16> m = { 0 };
+		REQUIRE(slot::init(m));
+
+		slot::handle<types::uint16> live[64];
+		for (types::uint16 i = 0; i < 64; ++i) {
+			live[i] = slot::insert(m, types::uint64(i));
+		}
+
+		for (types::uint32 round = 0; round < 10000; ++round) {
+			const auto i = (round * 7) % 64;
+			const auto old = live[i];
+			REQUIRE(slot::erase(m, old));
+
+			live[i] = slot::insert(m, types::uint64(round));
+			REQUIRE(slot::get(m, old) == nullptr);
+			REQUIRE(*slot::get(m, live[i]) == round);
+		}
+
+		REQUIRE(slot::get_count(m) == 64);
+		REQUIRE(m.slots.count == 64);
+
+		slot::release(m);
+	}
+
+	SECTION("Non-trivial elements") {
+		auto* m = slot::make<std::string>();
+		REQUIRE(m);
+
+		auto a = slot::insert(*m, std::string(64, 'a'));
+		auto b = slot::insert(*m, std::string(64, 'b'));
+		auto c = slot::insert(*m, std::string(64, 'c'));
+
+		REQUIRE(slot::erase(*m, a));
+		REQUIRE(*slot::get(*m, b) == std::string(64, 'b'));
+		REQUIRE(*slot::get(*m, c) == std::string(64, 'c'));
+		REQUIRE(slot::get_data(*m)[0] == std::string(64, 'c'));
+
+		slot::destroy(m);
+	}
+}
@@ -5,13 +5,28 @@
 // https://opensource.org/licenses/MIT
 
 #define __STDC_WANT_LIB_EXT1__ 1
+#include <chrono>
 #include <cstdio>
+#include <cstring>
+#include <thread>
 
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
 #include "angie/core/utils.hpp"
 #include "angie/core/memory/global.hpp"
+#include "angie/core/memory/manipulation.hpp"
+#include "angie/core/memory/linear.hpp"
+#include "angie/core/memory/pool.hpp"
+#include "angie/core/memory/vmem.hpp"
+#include "angie/core/memory/huge.hpp"
+#include "angie/core/memory/statistics.hpp"
+#include "angie/core/memory/profiler.hpp"
+#include "angie/core/memory/stack.hpp"
+#include "angie/core/memory/scratch.hpp"
+#include "angie/core/memory/budget.hpp"
+#include "angie/core/memory/trim.hpp"
+#include "angie/core/containers/dynamic_array.hpp"
 
 TEST_CASE( "Memory allocation", "[allocation]" )
 {
@@ -32,6 +47,24 @@ TEST_CASE( "Memory allocation", "[allocation]" )
         memory::deallocate(buffer);
     }
 
+    SECTION("Blocks larger than a backend area") {
+        // TLSF requests 32MB areas, these need one of their own
+        const size sizes[] = { (40 << 20) + 3, 96 << 20 };
+        for (auto sz : sizes) {
+            auto* buffer = static_cast<uint8*>(memory::allocate(sz, 64));
+            REQUIRE(buffer != nullptr);
+            REQUIRE(utils::is_multiple_of((size) buffer, 64));
+            REQUIRE(memory::size_of(buffer) >= sz);
+
+            memset(buffer, 0x5a, sz);
+            REQUIRE(buffer[0] == 0x5a);
+            REQUIRE(buffer[sz - 1] == 0x5a);
+            memory::deallocate(buffer);
+        }
+
+        memory::flush();
+    }
+
     SECTION("Simple C++ style allocations") {
         int8 * m = new int8;
         REQUIRE(m != nullptr);
@@ -89,5 +122,905 @@ TEST_CASE( "Memory allocation", "[allocation]" )
     }
 }
 
+TEST_CASE( "Linear arena", "[linear]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Bump allocation and reset") {
+        auto* arena = memory::linear::make(1024);
+        REQUIRE(arena != nullptr);
+        REQUIRE(memory::linear::get_capacity(*arena) == 1024);
+
+        auto* ator = memory::linear::get_allocator(*arena);
+        void* a = memory::alloc(ator, 100, 16);
+        void* b = memory::alloc(ator, 100, 64);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(utils::is_multiple_of((size) b, 64));
+        REQUIRE((byte*) b >= (byte*) a + 100);
+
+        // Arena exhausted
+        REQUIRE(memory::alloc(ator, 2048, 16) == nullptr);
+
+        memory::linear::reset(*arena);
+        REQUIRE(memory::linear::get_used(*arena) == 0);
+        REQUIRE(memory::alloc(ator, 100, 16) == a);
+
+        memory::linear::destroy(arena);
+        REQUIRE(arena == nullptr);
+    }
+
+    SECTION("Grow last block in place") {
+        auto* arena = memory::linear::make(256);
+        auto* ator = memory::linear::get_allocator(*arena);
+
+        char* a = (char*) memory::alloc(ator, 8, 8);
+        memcpy(a, "arena", 6);
+        REQUIRE(memory::realloc(ator, a, 64, 8) == a);
+
+        char* b = (char*) memory::alloc(ator, 8, 8);
+        char* c = (char*) memory::realloc(ator, a, 128, 8);
+        REQUIRE(c != a);
+        REQUIRE(c > b);
+        REQUIRE(strcmp(c, "arena") == 0);
+
+        memory::linear::destroy(arena);
+    }
+
+    SECTION("Dynamic arrays on an arena") {
+        auto* arena = memory::linear::make(4096);
+        auto* ator = memory::linear::get_allocator(*arena);
+
+        auto* u32_a = array::make<uint32>(4, ator);
+        REQUIRE(u32_a != nullptr);
+        for (uint32 i = 0; i < 100; ++i) {
+            REQUIRE(array::push(*u32_a, i));
+        }
+
+        REQUIRE(array::get_count(*u32_a) == 100);
+        REQUIRE(u32_a->data[99] == 99u);
+
+        array::destroy(u32_a);
+        memory::linear::destroy(arena);
+    }
+}
+
+TEST_CASE( "Pool allocator", "[pool]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Size classes and recycling") {
+        auto* pool = memory::pool::make();
+        REQUIRE(pool != nullptr);
+
+        auto* ator = memory::pool::get_allocator(*pool);
+        void* a = memory::alloc(ator, 24, 8);
+        void* b = memory::alloc(ator, 24, 8);
+        REQUIRE(a != nullptr);
+        REQUIRE(b != nullptr);
+        REQUIRE(memory::pool::size_of(*pool, a) == 32);
+        REQUIRE(utils::is_multiple_of((size) a, 32));
+
+        // Blocks of the same class are densely packed
+        REQUIRE((byte*) b == (byte*) a + 32);
+
+        memory::dealloc(ator, a);
+        REQUIRE(memory::alloc(ator, 32, 32) == a);
+
+        memory::pool::destroy(pool);
+        REQUIRE(pool == nullptr);
+    }
+
+    SECTION("Large blocks and reallocation") {
+        auto* pool = memory::pool::make();
+        auto* ator = memory::pool::get_allocator(*pool);
+
+        char* a = (char*) memory::alloc(ator, 16, 16);
+        memcpy(a, "pool", 5);
+
+        char* b = (char*) memory::realloc(ator, a, 1000, 64);
+        REQUIRE(b != nullptr);
+        REQUIRE(utils::is_multiple_of((size) b, 64));
+        REQUIRE(memory::pool::size_of(*pool, b) >= 1000);
+        REQUIRE(strcmp(b, "pool") == 0);
+
+        // Leave one large block alive, destroy() must release it.
+        void* c = memory::alloc(ator, 4000, 16);
+        REQUIRE(c != nullptr);
+        memory::dealloc(ator, b);
+
+        memory::pool::destroy(pool);
+    }
+
+    SECTION("Dynamic arrays on a pool") {
+        auto* pool = memory::pool::make();
+        auto* ator = memory::pool::get_allocator(*pool);
+
+        array::dynamic<uint32>* arrays[64];
+        for (auto& arr : arrays) {
+            arr = array::make<uint32>(2, ator);
+            REQUIRE(arr != nullptr);
+            REQUIRE(array::push(*arr, 7u));
+        }
+
+        for (auto& arr : arrays) {
+            REQUIRE(arr->data[0] == 7u);
+            array::destroy(arr);
+        }
+
+        memory::pool::destroy(pool);
+    }
+}
+
+TEST_CASE( "Virtual memory allocator", "[vmem]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Commit pages in place") {
+        auto* space = memory::vmem::make(64 << 20);
+        REQUIRE(space != nullptr);
+
+        auto* ator = memory::vmem::get_allocator(*space);
+        const size page = memory::vmem::get_page_size();
+
+        char* a = (char*) memory::alloc(ator, 64 << 10, 64);
+        REQUIRE(a != nullptr);
+        REQUIRE(utils::is_multiple_of((size) a, 64));
+        REQUIRE(memory::vmem::get_reserved(a) >= (64 << 20));
+        memcpy(a, "vmem", 5);
+
+        // Growing within the reservation never moves the block
+        char* b = (char*) memory::realloc(ator, a, 32 << 20, 0);
+        REQUIRE(b == a);
+        REQUIRE(memory::vmem::get_committed(b) >= (32 << 20));
+        REQUIRE(strcmp(b, "vmem") == 0);
+        b[(32 << 20) - 1] = 'x';
+
+        // Shrinking gives pages back
+        b = (char*) memory::realloc(ator, b, page, 0);
+        REQUIRE(b == a);
+        REQUIRE(memory::vmem::get_committed(b) <= 2 * page);
+
+        // Past the reservation, the block moves
+        char* c = (char*) memory::realloc(ator, b, 128 << 20, 0);
+        REQUIRE(c != nullptr);
+        REQUIRE(strcmp(c, "vmem") == 0);
+
+        memory::dealloc(ator, c);
+        memory::vmem::destroy(space);
+        REQUIRE(space == nullptr);
+    }
+
+    SECTION("Small blocks come from the parent") {
+        auto* space = memory::vmem::make();
+        auto* ator = memory::vmem::get_allocator(*space);
+
+        char* a = (char*) memory::alloc(ator, 16, 16);
+        REQUIRE(a != nullptr);
+        REQUIRE(memory::vmem::get_reserved(a) == 0);
+        memcpy(a, "small", 6);
+
+        char* b = (char*) memory::realloc(ator, a, 1 << 20, 16);
+        REQUIRE(b != nullptr);
+        REQUIRE(memory::vmem::get_reserved(b) > 0);
+        REQUIRE(strcmp(b, "small") == 0);
+
+        memory::dealloc(ator, b);
+        memory::vmem::destroy(space);
+    }
+
+    SECTION("Dynamic arrays grow without moving") {
+        auto* space = memory::vmem::make(64 << 20);
+        auto* ator = memory::vmem::get_allocator(*space);
+
+        auto* arr = array::make<uint32>(4096, ator);
+        REQUIRE(arr != nullptr);
+
+        const uint32* data = arr->data;
+        bool pushed = true;
+        for (uint32 i = 0; i < (1 << 20); ++i) {
+            pushed = array::push(*arr, i) && pushed;
+        }
+
+        REQUIRE(pushed);
+        REQUIRE(arr->data == data);
+        REQUIRE(arr->data[12345] == 12345u);
+
+        array::destroy(arr);
+        memory::vmem::destroy(space);
+    }
+}
+
+TEST_CASE( "Huge page allocator", "[huge]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Large blocks report their page size") {
+        auto* heap = memory::huge::make();
+        REQUIRE(heap != nullptr);
+
+        auto* ator = memory::huge::get_allocator(*heap);
+        const size block_size = 8 << 20;
+
+        byte* a = (byte*) memory::alloc(ator, block_size, 64);
+        REQUIRE(a != nullptr);
+        REQUIRE(utils::is_multiple_of((size) a, 64));
+        memset(a, 0xAB, block_size);
+
+        const size page = memory::huge::page_size_of(a);
+        REQUIRE((page == memory::vmem::get_page_size()
+            || page == memory::huge::get_huge_page_size()));
+
+        // Either huge pages are used, or we fell back to regular ones
+        if (memory::huge::is_transparent(a)) {
+            REQUIRE(page == memory::huge::get_huge_page_size());
+        }
+
+        byte* b = (byte*) memory::realloc(ator, a, block_size / 2, 0);
+        REQUIRE(b == a);
+
+        b = (byte*) memory::realloc(ator, b, block_size * 2, 0);
+        REQUIRE(b != nullptr);
+        REQUIRE(b[block_size / 2 - 1] == 0xAB);
+
+        memory::dealloc(ator, b);
+        memory::huge::destroy(heap);
+        REQUIRE(heap == nullptr);
+    }
+
+    SECTION("Small blocks come from the parent") {
+        auto* heap = memory::huge::make();
+        auto* ator = memory::huge::get_allocator(*heap);
+
+        void* a = memory::alloc(ator, 100, 16);
+        REQUIRE(a != nullptr);
+        REQUIRE(memory::huge::page_size_of(a) == 0);
+
+        memory::dealloc(ator, a);
+        memory::huge::destroy(heap);
+    }
+}
+
+TEST_CASE( "Allocation statistics", "[statistics]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Tracking allocator counters") {
+        auto* tracker = memory::stats::make();
+        REQUIRE(tracker != nullptr);
+
+        auto* ator = memory::stats::get_allocator(*tracker);
+        memory::stats::snapshot snap;
+
+        void* a = memory::alloc(ator, 100, 16);
+        void* b = memory::alloc(ator, 200, 64);
+        REQUIRE(utils::is_multiple_of((size) b, 64));
+        REQUIRE(memory::stats::query(ator, snap));
+        REQUIRE(snap.live == 300);
+        REQUIRE(snap.allocations == 2);
+        REQUIRE(snap.histogram[3] == 1); // up to 128 bytes
+        REQUIRE(snap.histogram[4] == 1); // up to 256 bytes
+
+        memory::dealloc(ator, a);
+        memcpy(b, "stats", 6);
+        b = memory::realloc(ator, b, 1 << 20, 0);
+        REQUIRE(strcmp((char*) b, "stats") == 0);
+
+        REQUIRE(memory::stats::query(ator, snap));
+        REQUIRE(snap.live == (1 << 20));
+        REQUIRE(snap.peak == (1 << 20));
+        REQUIRE(snap.deallocations == 1);
+        REQUIRE(snap.reallocations == 1);
+        REQUIRE(snap.copied <= 200);
+
+        memory::dealloc(ator, b);
+        REQUIRE(memory::stats::query(ator, snap));
+        REQUIRE(snap.live == 0);
+
+        memory::stats::destroy(tracker);
+        REQUIRE(tracker == nullptr);
+    }
 
+    SECTION("Global statistics") {
+        memory::stats::snapshot before;
+        const bool enabled = memory::stats::query(
+            memory::get_default_allocator(), before);
 
+#ifdef ANGIE_MEMORY_STATISTICS
+        REQUIRE(enabled);
+
+        void* ptr = memory::allocate(64);
+        memory::stats::snapshot after;
+        REQUIRE(memory::stats::query(
+            memory::get_default_allocator(), after));
+        REQUIRE(after.allocations > before.allocations);
+        REQUIRE(after.live >= before.live + 64);
+        REQUIRE(after.peak >= after.live);
+        memory::deallocate(ptr);
+#else
+        REQUIRE(!enabled);
+        REQUIRE(!memory::stats::start_report(
+            [](system::report::level, const char8*) {}));
+#endif
+    }
+}
+
+TEST_CASE( "Sampled heap profiler", "[profiler]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Live heap by call site") {
+        auto count_lines = [](const char8* line, void* user_data) {
+            REQUIRE(strrchr(line, ' ') != nullptr);
+            ++*static_cast<size*>(user_data);
+        };
+
+#ifdef ANGIE_MEMORY_PROFILER
+        const size rate = memory::profiler::get_sample_rate();
+        memory::profiler::set_sample_rate(1);
+
+        void* blocks[16];
+        for (auto& b : blocks) {
+            b = memory::allocate(1024);
+        }
+
+        size lines = 0;
+        REQUIRE(memory::profiler::dump(count_lines, &lines) > 0);
+        REQUIRE(lines > 0);
+
+        for (auto& b : blocks) {
+            memory::deallocate(b);
+        }
+
+        memory::profiler::set_sample_rate(rate);
+#else
+        size lines = 0;
+        REQUIRE(memory::profiler::get_sample_rate() == 0);
+        REQUIRE(memory::profiler::dump(count_lines, &lines) == 0);
+        REQUIRE(lines == 0);
+#endif
+    }
+}
+
+TEST_CASE( "Stack allocator", "[stack]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+    using memory::stack::side;
+
+    SECTION("LIFO frees and markers") {
+        auto* region = memory::stack::make(4096);
+        REQUIRE(region != nullptr);
+
+        auto* ator = memory::stack::get_allocator(*region);
+        const size initial = memory::stack::get_free(*region);
+
+        void* a = memory::alloc(ator, 100, 16);
+        auto mark = memory::stack::get_marker(*region);
+        void* b = memory::alloc(ator, 200, 64);
+        void* c = memory::alloc(ator, 300, 16);
+        REQUIRE(utils::is_multiple_of((size) b, 64));
+
+        // Blocks are released in reverse order
+        memory::dealloc(ator, c);
+        memory::dealloc(ator, b);
+        REQUIRE(memory::alloc(ator, 200, 64) == b);
+
+        memory::stack::free_to_marker(*region, mark);
+        REQUIRE(memory::alloc(ator, 200, 64) == b);
+
+        memory::stack::free_to_marker(*region, mark);
+        memory::dealloc(ator, a);
+        REQUIRE(memory::stack::get_free(*region) == initial);
+
+        memory::stack::destroy(region);
+        REQUIRE(region == nullptr);
+    }
+
+    SECTION("Double-ended allocation") {
+        auto* region = memory::stack::make(4096);
+        auto* low = memory::stack::get_allocator(*region, side::low);
+        auto* high = memory::stack::get_allocator(*region, side::high);
+
+        byte* l = (byte*) memory::alloc(low, 1000, 16);
+        byte* h = (byte*) memory::alloc(high, 1000, 16);
+        REQUIRE(l != nullptr);
+        REQUIRE(h != nullptr);
+        REQUIRE(h >= l + 1000);
+        REQUIRE(utils::is_multiple_of((size) h, 16));
+
+        // The two sides meet in the middle
+        REQUIRE(memory::alloc(low, 3000, 16) == nullptr);
+        REQUIRE(memory::alloc(high, 3000, 16) == nullptr);
+
+        // The last block of the high side grows downward
+        memcpy(h, "high", 5);
+        byte* h2 = (byte*) memory::realloc(high, h, 1500, 0);
+        REQUIRE(h2 != nullptr);
+        REQUIRE(h2 < h);
+        REQUIRE(strcmp((char*) h2, "high") == 0);
+
+        auto mark = memory::stack::get_marker(*region, side::high);
+        REQUIRE(memory::alloc(high, 500, 16) != nullptr);
+        memory::stack::free_to_marker(*region, mark, side::high);
+
+        memory::stack::reset(*region);
+        REQUIRE(memory::alloc(low, 3000, 16) != nullptr);
+
+        memory::stack::destroy(region);
+    }
+
+    SECTION("Dynamic arrays on a stack") {
+        auto* region = memory::stack::make(1 << 16);
+        auto* ator = memory::stack::get_allocator(*region);
+
+        auto* arr = array::make<uint32>(0, ator);
+        REQUIRE(arr != nullptr);
+        for (uint32 i = 0; i < 1000; ++i) {
+            REQUIRE(array::push(*arr, i));
+        }
+
+        REQUIRE(arr->data[999] == 999u);
+        memory::stack::destroy(region);
+    }
+}
+
+TEST_CASE( "In-place expansion", "[expand]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Global and default allocator") {
+        void* ptr = memory::allocate(100);
+        REQUIRE(memory::try_expand(ptr, 64));
+        REQUIRE(memory::try_expand(ptr, memory::size_of(ptr) / 2));
+        REQUIRE(!memory::try_expand(nullptr, 64));
+
+        auto* ator = memory::get_default_allocator();
+        REQUIRE(memory::try_expand(ator, ptr, 100));
+        memory::deallocate(ptr);
+    }
+
+    SECTION("Only the last block of an arena") {
+        auto* arena = memory::linear::make(4096);
+        auto* ator = memory::linear::get_allocator(*arena);
+
+        void* a = memory::alloc(ator, 64, 16);
+        void* b = memory::alloc(ator, 64, 16);
+        REQUIRE(!memory::try_expand(ator, a, 128));
+        REQUIRE(memory::try_expand(ator, b, 1024));
+        REQUIRE(memory::linear::get_used(*arena) >= 1024 + 64);
+        REQUIRE(!memory::try_expand(ator, b, 8192));
+
+        memory::linear::destroy(arena);
+    }
+
+    SECTION("Arrays grow without moving") {
+        auto* region = memory::stack::make(1 << 16);
+        auto* ator = memory::stack::get_allocator(*region);
+
+        array::dynamic<uint32> arr = { 0 };
+        REQUIRE(array::init(arr, 4, ator));
+        const uint32* data = arr.data;
+
+        for (uint32 i = 0; i < 4000; ++i) {
+            REQUIRE(array::push(arr, i));
+        }
+
+        REQUIRE(arr.data == data);
+        REQUIRE(arr.data[3999] == 3999u);
+
+        array::release(arr);
+        memory::stack::destroy(region);
+    }
+}
+
+TEST_CASE( "Sized and batch allocation", "[batch]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Sized deallocation") {
+        void* ptr = memory::allocate(48);
+        REQUIRE(ptr != nullptr);
+        memory::deallocate(ptr, 48);
+        memory::deallocate(nullptr, 48);
+
+        auto* ator = memory::get_default_allocator();
+        ptr = memory::alloc(ator, 20000, 64);
+        REQUIRE(ptr != nullptr);
+        memory::dealloc(ator, ptr, 20000);
+
+        // Arenas reclaim blocks freed in reverse order
+        auto* arena = memory::linear::make(1024);
+        auto* lator = memory::linear::get_allocator(*arena);
+        const size used = memory::linear::get_used(*arena);
+        void* a = memory::alloc(lator, 64, 16);
+        void* b = memory::alloc(lator, 48, 16);
+        memory::dealloc(lator, b, 48);
+        memory::dealloc(lator, a, 64);
+        REQUIRE(memory::linear::get_used(*arena) == used);
+        memory::linear::destroy(arena);
+
+        // Pools tell large blocks apart by their size
+        auto* heap = memory::pool::make();
+        auto* pator = memory::pool::get_allocator(*heap);
+        const size large = memory::pool::max_block_size * 2;
+        void* c = memory::alloc(pator, large, 16);
+        void* d = memory::alloc(pator, 24, 8);
+        REQUIRE(c != nullptr);
+        REQUIRE(d != nullptr);
+        memory::dealloc(pator, c, large);
+        memory::dealloc(pator, d, 24);
+        REQUIRE(memory::alloc(pator, 24, 8) == d);
+        memory::pool::destroy(heap);
+    }
+
+    SECTION("Batches of same size blocks") {
+        void* ptrs[256] = { nullptr };
+        REQUIRE(memory::allocate_n(ptrs, 256, 96, 32));
+
+        for (size i = 0; i < 256; ++i) {
+            REQUIRE(ptrs[i] != nullptr);
+            REQUIRE(angie_is_aligned(ptrs[i], 32));
+            memset(ptrs[i], int(i), 96);
+        }
+
+        for (size i = 0; i < 256; ++i) {
+            REQUIRE(static_cast<byte*>(ptrs[i])[95] == byte(i));
+        }
+
+        memory::deallocate_n(ptrs, 256, 96);
+
+        void* big[4] = { nullptr };
+        REQUIRE(memory::allocate_n(big, 4, 1 << 16));
+        memory::deallocate(big[2], 1 << 16);
+        big[2] = nullptr;
+        memory::deallocate_n(big, 4, 1 << 16);
+    }
+}
+
+TEST_CASE( "Memory manipulation kernels", "[manipulation]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    const char8* name = memory::select_kernels();
+    REQUIRE(name != nullptr);
+
+    SECTION("Sizes and alignments around the vector width") {
+        const size cap = 2048 + 64;
+        auto* src = static_cast<byte*>(memory::allocate(cap, 64));
+        auto* dst = static_cast<byte*>(memory::allocate(cap, 64));
+
+        for (size i = 0; i < cap; ++i) {
+            src[i] = byte(i * 7 + 1);
+        }
+
+        for (size offset = 0; offset < 64; offset += 13) {
+            for (size bytes = 0; bytes <= 2048; bytes += bytes < 300 ? 1 : 61) {
+                memset(dst, 0, cap);
+                REQUIRE(memory::copy(dst + offset, src + 3, bytes) == bytes);
+                REQUIRE(memory::is_equal(dst + offset, src + 3, bytes));
+                REQUIRE(memcmp(dst + offset, src + 3, bytes) == 0);
+                REQUIRE(dst[offset + bytes] == 0);
+                if (offset) REQUIRE(dst[offset - 1] == 0);
+
+                if (bytes) {
+                    dst[offset + bytes / 2] ^= 0x10;
+                    REQUIRE(!memory::is_equal(dst + offset, src + 3, bytes));
+                }
+
+                REQUIRE(memory::set(dst + offset, 0xab, bytes) == bytes);
+                for (size i = 0; i < bytes; ++i) {
+                    REQUIRE(dst[offset + i] == 0xab);
+                }
+
+                REQUIRE(dst[offset + bytes] == 0);
+            }
+        }
+
+        memory::deallocate(src);
+        memory::deallocate(dst);
+    }
+
+    SECTION("Large buffers") {
+        const size bytes = (64 << 20) + 33;
+        auto* src = static_cast<byte*>(memory::allocate(bytes));
+        auto* dst = static_cast<byte*>(memory::allocate(bytes + 1));
+        REQUIRE(src != nullptr);
+        REQUIRE(dst != nullptr);
+
+        REQUIRE(memory::set(src, 0x5a, bytes) == bytes);
+        src[bytes - 1] = 0x11;
+        REQUIRE(memory::copy(dst + 1, src, bytes) == bytes);
+        REQUIRE(memory::is_equal(dst + 1, src, bytes));
+        REQUIRE(dst[1] == 0x5a);
+        REQUIRE(dst[bytes] == 0x11);
+
+        memory::deallocate(src);
+        memory::deallocate(dst);
+    }
+
+    SECTION("Streaming past the threshold") {
+        // The last level cache might be bigger than the buffers
+        const size previous = memory::set_stream_threshold(4096);
+
+        const size bytes = (1 << 20) + 45;
+        auto* src = static_cast<byte*>(memory::allocate(bytes + 1));
+        auto* dst = static_cast<byte*>(memory::allocate(bytes + 1));
+        REQUIRE(src != nullptr);
+        REQUIRE(dst != nullptr);
+
+        REQUIRE(memory::set(src + 1, 0x3c, bytes) == bytes);
+        src[bytes] = 0x22;
+        REQUIRE(memory::copy(dst, src + 1, bytes) == bytes);
+        REQUIRE(memory::is_equal(dst, src + 1, bytes));
+        REQUIRE(dst[0] == 0x3c);
+        REQUIRE(dst[bytes - 1] == 0x22);
+
+        memory::set_stream_threshold(previous);
+        memory::deallocate(src);
+        memory::deallocate(dst);
+    }
+}
+
+TEST_CASE( "Scratch allocator", "[scratch]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Nested scopes rewind on exit") {
+        size before = 0;
+        {
+            memory::scratch::scope outer;
+            auto* ator = outer.get_allocator();
+            REQUIRE(ator != memory::get_default_allocator());
+
+            before = memory::scratch::get_free();
+            void* a = memory::alloc(ator, 1024, 16);
+            REQUIRE(a != nullptr);
+            const size after_outer = memory::scratch::get_free();
+            REQUIRE(after_outer < before);
+
+            {
+                memory::scratch::scope inner;
+                void* b = memory::alloc(inner.get_allocator(), 4096, 64);
+                REQUIRE(b != nullptr);
+                REQUIRE(angie_is_aligned(b, 64));
+                REQUIRE(memory::scratch::get_free() < after_outer);
+            }
+
+            REQUIRE(memory::scratch::get_free() == after_outer);
+        }
+
+        REQUIRE(memory::scratch::get_free() == before);
+    }
+
+    SECTION("Temporary arrays") {
+        const size before = memory::scratch::get_free();
+        {
+            memory::scratch::scope tmp;
+
+            array::dynamic<uint32> a = { 0 };
+            array::dynamic<uint64> b = { 0 };
+            REQUIRE(array::init(a, 8, tmp.get_allocator()));
+            REQUIRE(array::init(b, 8, tmp.get_allocator()));
+
+            for (uint32 i = 0; i < 5000; ++i) {
+                REQUIRE(array::push(a, i));
+                REQUIRE(array::push(b, uint64(i) << 32));
+            }
+
+            REQUIRE(a.data[4999] == 4999u);
+            REQUIRE(b.data[4999] == uint64(4999) << 32);
+        }
+
+        REQUIRE(memory::scratch::get_free() == before);
+    }
+
+    SECTION("Exhausted scratch memory") {
+        memory::scratch::scope tmp;
+        auto* ator = tmp.get_allocator();
+        REQUIRE(memory::alloc(ator, ANGIE_MEMORY_SCRATCH_SIZE + 1, 16)
+            == nullptr);
+    }
+}
+
+namespace {
+
+    struct pressure_state {
+        angie::core::types::size    calls;
+        angie::core::types::size    used;
+        void*                       evictable;
+    };
+
+    void on_pressure(angie::core::memory::budget::account& a,
+                     angie::core::types::size used, void* user_data) {
+        auto* state = static_cast<pressure_state*>(user_data);
+        ++state->calls;
+        state->used = used;
+
+        // Evict the cache, making room for the request
+        angie::core::memory::dealloc(
+            angie::core::memory::budget::get_allocator(a), state->evictable);
+        state->evictable = nullptr;
+    }
+
+    void count_accounts(const angie::core::memory::budget::account&,
+                        void* user_data) {
+        ++*static_cast<angie::core::types::size*>(user_data);
+    }
+
+}
+
+TEST_CASE( "Memory budgets", "[budget]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Hard limit fails fast") {
+        auto* audio = memory::budget::make("audio", 0, 4096);
+        REQUIRE(audio != nullptr);
+        auto* ator = memory::budget::get_allocator(*audio);
+
+        void* a = memory::alloc(ator, 3000, 16);
+        REQUIRE(a != nullptr);
+        REQUIRE(memory::budget::get_used(*audio) == 3000);
+
+        REQUIRE(memory::alloc(ator, 2000, 16) == nullptr);
+        REQUIRE(memory::realloc(ator, a, 5000, 0) == nullptr);
+        REQUIRE(memory::budget::get_failures(*audio) == 2);
+        REQUIRE(memory::budget::get_used(*audio) == 3000);
+
+        a = memory::realloc(ator, a, 1000, 0);
+        REQUIRE(a != nullptr);
+        REQUIRE(memory::budget::get_used(*audio) == 1000);
+        REQUIRE(memory::budget::get_peak(*audio) == 3000);
+
+        memory::dealloc(ator, a);
+        REQUIRE(memory::budget::get_used(*audio) == 0);
+        memory::budget::destroy(audio);
+        REQUIRE(audio == nullptr);
+    }
+
+    SECTION("Soft limit fires the pressure callback") {
+        pressure_state state = { 0, 0, nullptr };
+        auto* textures = memory::budget::make("textures", 1 << 12, 1 << 13,
+            on_pressure, &state);
+        auto* ator = memory::budget::get_allocator(*textures);
+
+        state.evictable = memory::alloc(ator, 3 << 10, 16);
+        void* b = memory::alloc(ator, 2 << 10, 16);
+        REQUIRE(b != nullptr);
+        REQUIRE(state.calls == 1);
+        REQUIRE(state.used == 5 << 10);
+        REQUIRE(state.evictable == nullptr);
+        REQUIRE(memory::budget::get_used(*textures) == 2 << 10);
+
+        // Below the limit again, the next crossing fires again
+        void* c = memory::alloc(ator, 3 << 10, 16);
+        REQUIRE(c != nullptr);
+        REQUIRE(state.calls == 2);
+
+        memory::dealloc(ator, b);
+        memory::dealloc(ator, c);
+        memory::budget::destroy(textures);
+    }
+
+    SECTION("Usage per tag") {
+        auto* streaming = memory::budget::make("streaming", 0, 0);
+        auto* meshes = memory::budget::make("meshes", 0, 0);
+
+        void* m = memory::alloc(memory::budget::get_allocator(*meshes),
+            100, 16);
+        REQUIRE(memory::budget::find("meshes") == meshes);
+        REQUIRE(memory::budget::find("streaming") == streaming);
+        REQUIRE(memory::budget::find("unknown") == nullptr);
+        REQUIRE(memory::budget::get_used(*memory::budget::find("meshes"))
+            == 100);
+
+        size count = 0;
+        memory::budget::for_each(count_accounts, &count);
+        REQUIRE(count == 2);
+
+        memory::dealloc(memory::budget::get_allocator(*meshes), m);
+        memory::budget::destroy(meshes);
+        memory::budget::destroy(streaming);
+        REQUIRE(memory::budget::find("meshes") == nullptr);
+    }
+}
+
+TEST_CASE( "Background trimming", "[trim]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Resident size") {
+#if defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+        REQUIRE(memory::trim::get_resident_size() > 0);
+#endif
+    }
+
+    SECTION("Start and stop") {
+        const size flushes = memory::trim::get_flushes();
+
+#ifdef ANGIE_MEMORY_TRIMMER
+        // No target, the idle process gets flushed within a few periods
+        REQUIRE(memory::trim::start(nullptr, 0, 5));
+        REQUIRE_FALSE(memory::trim::start(nullptr, 0, 5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        memory::trim::stop();
+        REQUIRE(memory::trim::get_flushes() > flushes);
+#else
+        REQUIRE_FALSE(memory::trim::start(nullptr, 0, 5));
+        REQUIRE(memory::trim::get_flushes() == flushes);
+#endif
+
+        // Stopping twice, or without starting, is harmless
+        memory::trim::stop();
+    }
+}
+
+TEST_CASE( "Thread cache", "[cache]" )
+{
+    using namespace angie::core;
+    using namespace angie::core::types;
+
+    SECTION("Blocks freed by another thread") {
+        const size count = 512;
+        void* blocks[count] = {};
+
+        std::thread([&] {
+            for (size i = 0; i < count; ++i) {
+                blocks[i] = memory::allocate(64);
+                if (blocks[i]) memset(blocks[i], int(i & 0xff), 64);
+            }
+        }).join();
+
+        for (size i = 0; i < count; ++i) {
+            REQUIRE(blocks[i] != nullptr);
+        }
+
+        // The owner has exited, its heap gets these back remotely
+        size intact = 0;
+        std::thread([&] {
+            for (size i = 0; i < count; ++i) {
+                if (static_cast<byte*>(blocks[i])[63] == byte(i & 0xff)) {
+                    ++intact;
+                }
+
+                memory::deallocate(blocks[i]);
+            }
+        }).join();
+
+        REQUIRE(intact == count);
+
+#ifdef ANGIE_MEMORY_THREAD_CACHE
+        // The next thread adopts the heap, and reuses all of them
+        // once the spans it carves blocks from are exhausted.
+        size reused = 0;
+        std::thread([&] {
+            void* fresh[4 * count] = {};
+            for (size n = 0; n < 4 * count && reused < count; ++n) {
+                fresh[n] = memory::allocate(64);
+                for (size i = 0; i < count; ++i) {
+                    if (fresh[n] && fresh[n] == blocks[i]) ++reused;
+                }
+            }
+
+            for (auto* ptr : fresh) {
+                memory::deallocate(ptr);
+            }
+        }).join();
+
+        REQUIRE(reused == count);
+#endif
+    }
+}